@@ -792,7 +792,19 @@ namespace OpenRCT2
                 {
                     gNetworkStartPort = gConfigNetwork.default_port;
                 }
-                network_begin_client(gNetworkStartHost, gNetworkStartPort);
+
+                if (gNetworkStartRelayPort != 0)
+                {
+                    if (gNetworkStartAddress.empty())
+                    {
+                        gNetworkStartAddress = gConfigNetwork.listen_address;
+                    }
+                    network_begin_relay(gNetworkStartHost, gNetworkStartPort, gNetworkStartRelayPort, gNetworkStartAddress);
+                }
+                else
+                {
+                    network_begin_client(gNetworkStartHost, gNetworkStartPort);
+                }
             }
 #endif // DISABLE_NETWORK
 
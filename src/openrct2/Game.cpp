@@ -474,7 +474,9 @@ int32_t game_do_command_p(
             }
 
             // Second call to actually perform the operation
+            bool trackedIdleTiles = map_track_idle_tile_changes(!(flags & GAME_COMMAND_FLAG_GHOST));
             new_game_command_table[command](eax, ebx, ecx, edx, esi, edi, ebp);
+            map_track_idle_tile_changes(trackedIdleTiles);
 
             if (replayManager != nullptr)
             {
@@ -872,7 +874,16 @@ void game_load_init()
     {
         reset_sprite_spatial_index();
     }
+    else
+    {
+        // The server sends its quadrant lists after the park, keep them but index them by tile.
+        reset_sprite_spatial_buckets();
+    }
     reset_all_sprite_quadrant_placements();
+    map_reset_path_wide_flags();
+    map_invalidate_idle_tiles();
+    park_reset_size_tiles();
+    map_animation_auto_create();
     scenery_set_default_placement_configuration();
 
     auto intent = Intent(INTENT_ACTION_REFRESH_NEW_RIDES);
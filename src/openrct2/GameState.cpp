@@ -37,6 +37,12 @@
 
 using namespace OpenRCT2;
 
+// Clients this many ticks behind the server stop updating the interface until they are close again.
+constexpr uint32_t NETWORK_CATCHUP_START_TICKS = 80;
+constexpr uint32_t NETWORK_CATCHUP_END_TICKS = 4;
+// Longest time spent on catching up before a frame is drawn, so the progress remains visible.
+constexpr uint32_t NETWORK_CATCHUP_FRAME_TIME = 250;
+
 GameState::GameState()
 {
     _park = std::make_unique<Park>();
@@ -114,6 +120,12 @@ void GameState::Update()
         numUpdates = 1 << (gGameSpeed - 1);
     }
 
+    if (UpdateCatchUp())
+    {
+        gInUpdateCode = false;
+        return;
+    }
+
     if (network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED
         && network_get_authstatus() == NETWORK_AUTH_OK)
     {
@@ -290,10 +302,16 @@ void GameState::UpdateLogic()
     ride_measurements_update();
     news_item_update_current();
 
+    // Some animations change the game state, so they have to run even while catching up with the server.
     map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
+
+    // Nothing is heard while catching up with the server.
+    if (!_catchingUp)
+    {
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+    }
     editor_open_windows_for_current_step();
 
     // Update windows
@@ -330,6 +348,73 @@ void GameState::UpdateLogic()
     gSavedAge++;
 }
 
+/**
+ * Runs as many logic-only updates as possible while the client is far behind the server, e.g. after joining a big
+ * park or recovering from a stall. Input, windows, audio and drawing are skipped, except for one frame every
+ * NETWORK_CATCHUP_FRAME_TIME to show the progress. Returns false once the client is close enough to the server to
+ * continue with regular updates.
+ */
+bool GameState::UpdateCatchUp()
+{
+    auto getTicksBehind = []() -> uint32_t {
+        if (network_get_mode() != NETWORK_MODE_CLIENT || network_get_status() != NETWORK_STATUS_CONNECTED
+            || network_get_authstatus() != NETWORK_AUTH_OK)
+        {
+            return 0;
+        }
+        // The client may be one tick ahead after running the tick the server is on.
+        uint32_t ticksBehind = network_get_server_tick() - gCurrentTicks;
+        return ticksBehind <= INT32_MAX ? ticksBehind : 0;
+    };
+
+    uint32_t ticksBehind = getTicksBehind();
+    if (!_catchingUp)
+    {
+        if (ticksBehind < NETWORK_CATCHUP_START_TICKS || game_is_paused())
+        {
+            return false;
+        }
+
+        log_verbose("Catching up with the server, %u ticks behind", ticksBehind);
+        _catchingUp = true;
+        _catchUpStartTick = gCurrentTicks;
+    }
+
+    uint32_t startTime = Platform::GetTicks();
+    while (ticksBehind > NETWORK_CATCHUP_END_TICKS && Platform::GetTicks() - startTime < NETWORK_CATCHUP_FRAME_TIME)
+    {
+        UpdateLogic();
+        ticksBehind = getTicksBehind();
+    }
+
+    if (ticksBehind > NETWORK_CATCHUP_END_TICKS)
+    {
+        char str_catching_up[256];
+        uint32_t catching_up_args[2] = {
+            gCurrentTicks - _catchUpStartTick,
+            network_get_server_tick() - _catchUpStartTick,
+        };
+        format_string(str_catching_up, sizeof(str_catching_up), STR_MULTIPLAYER_CATCHING_UP, catching_up_args);
+
+        auto intent = Intent(WC_NETWORK_STATUS);
+        intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_catching_up });
+        intent.putExtra(INTENT_EXTRA_CALLBACK, []() -> void { network_close(); });
+        context_open_intent(&intent);
+        _catchUpProgressShown = true;
+        return true;
+    }
+
+    log_verbose("Caught up with the server after %u ticks", gCurrentTicks - _catchUpStartTick);
+    _catchingUp = false;
+    if (_catchUpProgressShown && network_get_status() == NETWORK_STATUS_CONNECTED)
+    {
+        // Otherwise the status window tells why the connection was lost.
+        context_force_close_window_by_class(WC_NETWORK_STATUS);
+    }
+    _catchUpProgressShown = false;
+    return false;
+}
+
 void GameState::CreateStateSnapshot()
 {
     IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
@@ -25,6 +25,9 @@ namespace OpenRCT2
     private:
         std::unique_ptr<Park> _park;
         Date _date;
+        bool _catchingUp = false;
+        bool _catchUpProgressShown = false;
+        uint32_t _catchUpStartTick = 0;
 
     public:
         GameState();
@@ -45,5 +48,6 @@ namespace OpenRCT2
 
     private:
         void CreateStateSnapshot();
+        bool UpdateCatchUp();
     };
 } // namespace OpenRCT2
@@ -3,100 +3,175 @@
 #include "core/CircularBuffer.h"
 #include "peep/Peep.h"
 #include "world/Sprite.h"
+#include "zlib.h"
 
-static constexpr size_t MaximumGameStateSnapshots = 32;
+static constexpr size_t MaximumGameStateSnapshots = 16384;
+static constexpr size_t FullGameStateSnapshotInterval = 256;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
-struct GameStateSnapshot_t
+static rct_sprite GetEmptySprite()
 {
-    GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv)
+    rct_sprite sprite = {};
+    sprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+    return sprite;
+}
+
+static void SerialiseSprites(DataSerialiser& ds, rct_sprite* sprites, const size_t numSprites)
+{
+    std::vector<uint32_t> indexTable;
+    indexTable.reserve(numSprites);
+
+    uint32_t numSavedSprites = 0;
+
+    if (ds.IsSaving())
+    {
+        for (size_t i = 0; i < numSprites; i++)
+        {
+            if (sprites[i].generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
+                continue;
+            indexTable.push_back((uint32_t)i);
+        }
+        numSavedSprites = (uint32_t)indexTable.size();
+    }
+
+    ds << numSavedSprites;
+
+    if (ds.IsLoading())
     {
-        tick = mv.tick;
-        storedSprites = std::move(mv.storedSprites);
-        return *this;
+        indexTable.resize(numSavedSprites);
+    }
+
+    for (uint32_t i = 0; i < numSavedSprites; i++)
+    {
+        ds << indexTable[i];
+
+        const uint32_t spriteIdx = indexTable[i];
+        rct_sprite& sprite = sprites[spriteIdx];
+
+        ds << sprite.generic.sprite_identifier;
+
+        switch (sprite.generic.sprite_identifier)
+        {
+            case SPRITE_IDENTIFIER_VEHICLE:
+                ds << reinterpret_cast<uint8_t(&)[sizeof(rct_vehicle)]>(sprite.vehicle);
+                break;
+            case SPRITE_IDENTIFIER_PEEP:
+                ds << reinterpret_cast<uint8_t(&)[sizeof(Peep)]>(sprite.peep);
+                break;
+            case SPRITE_IDENTIFIER_LITTER:
+                ds << reinterpret_cast<uint8_t(&)[sizeof(rct_litter)]>(sprite.litter);
+                break;
+            case SPRITE_IDENTIFIER_MISC:
+            {
+                ds << sprite.generic.type;
+                switch (sprite.generic.type)
+                {
+                    case SPRITE_MISC_MONEY_EFFECT:
+                        ds << reinterpret_cast<uint8_t(&)[sizeof(rct_money_effect)]>(sprite.money_effect);
+                        break;
+                    case SPRITE_MISC_BALLOON:
+                        ds << reinterpret_cast<uint8_t(&)[sizeof(rct_balloon)]>(sprite.balloon);
+                        break;
+                    case SPRITE_MISC_DUCK:
+                        ds << reinterpret_cast<uint8_t(&)[sizeof(rct_duck)]>(sprite.duck);
+                        break;
+                    case SPRITE_MISC_JUMPING_FOUNTAIN_WATER:
+                        ds << reinterpret_cast<uint8_t(&)[sizeof(rct_jumping_fountain)]>(sprite.jumping_fountain);
+                        break;
+                    case SPRITE_MISC_STEAM_PARTICLE:
+                        ds << reinterpret_cast<uint8_t(&)[sizeof(rct_steam_particle)]>(sprite.steam_particle);
+                        break;
+                }
+            }
+            break;
+        }
     }
+}
 
+/*
+ * A snapshot only stores the sprites that changed since the previous snapshot, each as the XOR of the
+ * old and the new sprite which is mostly zero and compresses well. The first snapshot of a chain is
+ * stored against a list of empty sprites.
+ */
+struct GameStateSnapshot_t : public std::enable_shared_from_this<GameStateSnapshot_t>
+{
     uint32_t tick = InvalidTick;
     uint32_t srand0 = 0;
 
+    std::shared_ptr<const GameStateSnapshot_t> previous;
     MemoryStream storedSprites;
+    uint32_t storedSpritesSize = 0;
     MemoryStream parkParameters;
 
-    void SerialiseSprites(rct_sprite* sprites, const size_t numSprites, bool saving)
+    void StoreChanges(const rct_sprite* previousSprites, const rct_sprite* sprites, const size_t numSprites)
     {
-        const bool loading = !saving;
-
-        storedSprites.SetPosition(0);
-        DataSerialiser ds(saving, storedSprites);
-
-        std::vector<uint32_t> indexTable;
-        indexTable.reserve(numSprites);
+        MemoryStream changes;
+        for (size_t i = 0; i < numSprites; i++)
+        {
+            if (std::memcmp(&previousSprites[i], &sprites[i], sizeof(rct_sprite)) == 0)
+                continue;
 
-        uint32_t numSavedSprites = 0;
+            const uint8_t* previousData = reinterpret_cast<const uint8_t*>(&previousSprites[i]);
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(&sprites[i]);
 
-        if (saving)
-        {
-            for (size_t i = 0; i < numSprites; i++)
+            uint8_t delta[sizeof(rct_sprite)];
+            for (size_t j = 0; j < sizeof(rct_sprite); j++)
             {
-                if (sprites[i].generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
-                    continue;
-                indexTable.push_back((uint32_t)i);
+                delta[j] = previousData[j] ^ data[j];
             }
-            numSavedSprites = (uint32_t)indexTable.size();
+
+            changes.WriteValue<uint32_t>((uint32_t)i);
+            changes.Write(delta, sizeof(delta));
         }
 
-        ds << numSavedSprites;
+        storedSpritesSize = (uint32_t)changes.GetLength();
 
-        if (loading)
+        uLongf compressedSize = compressBound(storedSpritesSize);
+        auto compressed = std::make_unique<uint8_t[]>(compressedSize);
+        compress2(compressed.get(), &compressedSize, (const Bytef*)changes.GetData(), storedSpritesSize, Z_BEST_SPEED);
+
+        storedSprites.SetPosition(0);
+        storedSprites.Write(compressed.get(), compressedSize);
+    }
+
+    /**
+     * @returns false if the stored changes are corrupt, the sprites are left untouched in that case.
+     */
+    bool ApplyChanges(rct_sprite* sprites, const size_t numSprites) const
+    {
+        auto changes = std::make_unique<uint8_t[]>(storedSpritesSize);
+        uLongf changesSize = storedSpritesSize;
+        int err = uncompress(
+            changes.get(), &changesSize, (const Bytef*)storedSprites.GetData(), (uLong)storedSprites.GetLength());
+
+        const size_t entrySize = sizeof(uint32_t) + sizeof(rct_sprite);
+        if (err != Z_OK || changesSize != storedSpritesSize || changesSize % entrySize != 0)
         {
-            indexTable.resize(numSavedSprites);
+            return false;
         }
-
-        for (uint32_t i = 0; i < numSavedSprites; i++)
+        for (size_t offset = 0; offset < changesSize; offset += entrySize)
         {
-            ds << indexTable[i];
-
-            const uint32_t spriteIdx = indexTable[i];
-            rct_sprite& sprite = sprites[spriteIdx];
+            uint32_t spriteIdx;
+            std::memcpy(&spriteIdx, changes.get() + offset, sizeof(spriteIdx));
+            if (spriteIdx >= numSprites)
+            {
+                return false;
+            }
+        }
 
-            ds << sprite.generic.sprite_identifier;
+        for (size_t offset = 0; offset < changesSize; offset += entrySize)
+        {
+            uint32_t spriteIdx;
+            std::memcpy(&spriteIdx, changes.get() + offset, sizeof(spriteIdx));
 
-            switch (sprite.generic.sprite_identifier)
+            uint8_t* data = reinterpret_cast<uint8_t*>(&sprites[spriteIdx]);
+            const uint8_t* delta = changes.get() + offset + sizeof(uint32_t);
+            for (size_t j = 0; j < sizeof(rct_sprite); j++)
             {
-                case SPRITE_IDENTIFIER_VEHICLE:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(rct_vehicle)]>(sprite.vehicle);
-                    break;
-                case SPRITE_IDENTIFIER_PEEP:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(Peep)]>(sprite.peep);
-                    break;
-                case SPRITE_IDENTIFIER_LITTER:
-                    ds << reinterpret_cast<uint8_t(&)[sizeof(rct_litter)]>(sprite.litter);
-                    break;
-                case SPRITE_IDENTIFIER_MISC:
-                {
-                    ds << sprite.generic.type;
-                    switch (sprite.generic.type)
-                    {
-                        case SPRITE_MISC_MONEY_EFFECT:
-                            ds << reinterpret_cast<uint8_t(&)[sizeof(rct_money_effect)]>(sprite.money_effect);
-                            break;
-                        case SPRITE_MISC_BALLOON:
-                            ds << reinterpret_cast<uint8_t(&)[sizeof(rct_balloon)]>(sprite.balloon);
-                            break;
-                        case SPRITE_MISC_DUCK:
-                            ds << reinterpret_cast<uint8_t(&)[sizeof(rct_duck)]>(sprite.duck);
-                            break;
-                        case SPRITE_MISC_JUMPING_FOUNTAIN_WATER:
-                            ds << reinterpret_cast<uint8_t(&)[sizeof(rct_jumping_fountain)]>(sprite.jumping_fountain);
-                            break;
-                        case SPRITE_MISC_STEAM_PARTICLE:
-                            ds << reinterpret_cast<uint8_t(&)[sizeof(rct_steam_particle)]>(sprite.steam_particle);
-                            break;
-                    }
-                }
-                break;
+                data[j] ^= delta[j];
             }
         }
+        return true;
     }
 };
 
@@ -105,11 +180,12 @@ struct GameStateSnapshots : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _lastCapture.reset();
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
-        auto snapshot = std::make_unique<GameStateSnapshot_t>();
+        auto snapshot = std::make_shared<GameStateSnapshot_t>();
         _snapshots.push_back(std::move(snapshot));
 
         return *_snapshots.back();
@@ -123,7 +199,29 @@ struct GameStateSnapshots : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(get_sprite(0), MAX_SPRITES, true);
+        const rct_sprite emptySprite = GetEmptySprite();
+
+        _captureSprites.resize(MAX_SPRITES);
+        for (size_t i = 0; i < MAX_SPRITES; i++)
+        {
+            const rct_sprite* sprite = get_sprite(i);
+            _captureSprites[i] = sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL ? emptySprite : *sprite;
+        }
+
+        // Start a new chain every now and then so evicted snapshots are eventually released.
+        if (_lastCapture == nullptr || _capturesInChain >= FullGameStateSnapshotInterval)
+        {
+            _lastCaptureSprites.assign(MAX_SPRITES, emptySprite);
+            _lastCapture.reset();
+            _capturesInChain = 0;
+        }
+
+        snapshot.previous = _lastCapture;
+        snapshot.StoreChanges(_lastCaptureSprites.data(), _captureSprites.data(), MAX_SPRITES);
+
+        _lastCapture = snapshot.shared_from_this();
+        _lastCaptureSprites.swap(_captureSprites);
+        _capturesInChain++;
 
         // log_info("Snapshot size: %u bytes", (uint32_t)snapshot.storedSprites.GetLength());
     }
@@ -142,22 +240,57 @@ struct GameStateSnapshots : public IGameStateSnapshots
     {
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+
+        // The sprites are always exchanged in full.
+        MemoryStream storedSprites;
+        if (ds.IsSaving())
+        {
+            std::vector<rct_sprite> spriteList = BuildSpriteList(snapshot);
+            if (spriteList.empty())
+            {
+                // Send no sprites rather than garbage, the receiver will report every sprite as mismatching.
+                spriteList.assign(MAX_SPRITES, GetEmptySprite());
+            }
+            DataSerialiser spritesDs(true, storedSprites);
+            SerialiseSprites(spritesDs, spriteList.data(), MAX_SPRITES);
+        }
+
+        ds << storedSprites;
+
+        if (ds.IsLoading())
+        {
+            std::vector<rct_sprite> emptyList(MAX_SPRITES, GetEmptySprite());
+            std::vector<rct_sprite> spriteList = emptyList;
+
+            storedSprites.SetPosition(0);
+            DataSerialiser spritesDs(false, storedSprites);
+            SerialiseSprites(spritesDs, spriteList.data(), MAX_SPRITES);
+
+            snapshot.previous.reset();
+            snapshot.StoreChanges(emptyList.data(), spriteList.data(), MAX_SPRITES);
+        }
+
         ds << snapshot.parkParameters;
     }
 
-    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    std::vector<rct_sprite> BuildSpriteList(const GameStateSnapshot_t& snapshot) const
     {
-        std::vector<rct_sprite> spriteList;
-        spriteList.resize(MAX_SPRITES);
-
-        for (auto& sprite : spriteList)
+        std::vector<const GameStateSnapshot_t*> chain;
+        for (const GameStateSnapshot_t* link = &snapshot; link != nullptr; link = link->previous.get())
         {
-            // By default they don't exist.
-            sprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+            chain.push_back(link);
         }
 
-        snapshot.SerialiseSprites(spriteList.data(), MAX_SPRITES, false);
+        // By default they don't exist.
+        std::vector<rct_sprite> spriteList(MAX_SPRITES, GetEmptySprite());
+        for (auto it = chain.rbegin(); it != chain.rend(); it++)
+        {
+            if (!(*it)->ApplyChanges(spriteList.data(), spriteList.size()))
+            {
+                log_error("Game state snapshot of tick %u is corrupt", (*it)->tick);
+                return {};
+            }
+        }
 
         return spriteList;
     }
@@ -415,8 +548,12 @@ struct GameStateSnapshots : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        std::vector<rct_sprite> spritesBase = BuildSpriteList(base);
+        std::vector<rct_sprite> spritesCmp = BuildSpriteList(cmp);
+        if (spritesBase.empty() || spritesCmp.empty())
+        {
+            return res;
+        }
 
         for (uint32_t i = 0; i < (uint32_t)spritesBase.size(); i++)
         {
@@ -569,7 +706,11 @@ struct GameStateSnapshots : public IGameStateSnapshots
     }
 
 private:
-    CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    CircularBuffer<std::shared_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    std::shared_ptr<const GameStateSnapshot_t> _lastCapture;
+    std::vector<rct_sprite> _lastCaptureSprites;
+    std::vector<rct_sprite> _captureSprites;
+    size_t _capturesInChain = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
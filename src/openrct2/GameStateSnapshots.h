@@ -55,8 +55,8 @@ struct GameStateCompareData_t
 };
 
 /*
- * Interface to create and capture game states. It only allows to have 32 active snapshots
- * the oldest snapshot will be removed from the buffer. Never store the snapshot pointer
+ * Interface to create and capture game states. Snapshots are stored as compressed changes against
+ * the previous one, the oldest snapshot will be removed from the buffer. Never store the snapshot pointer
  * as it may become invalid at any time when a snapshot is created, rather Link the snapshot
  * to a specific tick which can be obtained by that later again assuming its still valid.
  */
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
 #include "PlatformEnvironment.h"
@@ -22,6 +23,8 @@
 #include "actions/TrackPlaceAction.hpp"
 #include "config/Config.h"
 #include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileStream.hpp"
 #include "core/Path.hpp"
 #include "management/NewsItem.h"
 #include "object/ObjectManager.h"
@@ -30,8 +33,13 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace OpenRCT2
@@ -92,6 +100,134 @@ namespace OpenRCT2
         MemoryStream data;
     };
 
+    // Since version 3 a replay file is the magic and version followed by a sequence of
+    // individually compressed chunks, so recording can append to it as it goes.
+    enum REPLAY_CHUNK : uint8_t
+    {
+        REPLAY_CHUNK_HEADER,   // Park and replay description, always the first chunk.
+        REPLAY_CHUNK_TICKS,    // Commands and checksums up to (excluding) the chunk tick.
+        REPLAY_CHUNK_END,      // Last tick of the replay, missing if the recording was interrupted.
+        REPLAY_CHUNK_KEYFRAME, // Full park state at the chunk tick, used for seeking.
+    };
+
+    struct ReplayChunkHeader
+    {
+        uint8_t type;
+        uint32_t tick;
+        uint32_t uncompressedSize;
+        uint32_t compressedSize;
+    };
+
+    /**
+     * Compresses and appends chunks to a replay file on a background thread.
+     */
+    class ReplayChunkWriter
+    {
+        static constexpr int ReplayCompressionLevel = 9;
+
+    public:
+        explicit ReplayChunkWriter(std::unique_ptr<IStream>&& stream)
+            : _stream(std::move(stream))
+        {
+            _thread = std::thread(&ReplayChunkWriter::ProcessQueue, this);
+        }
+
+        ~ReplayChunkWriter()
+        {
+            Finish();
+        }
+
+        void Enqueue(uint8_t type, uint32_t tick, MemoryStream&& data)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _pending.push_back({ { type, tick, 0, 0 }, std::move(data) });
+            _condPending.notify_one();
+        }
+
+        /**
+         * Waits for all queued chunks to be written and closes the file.
+         * @return false if any of the chunks could not be written.
+         */
+        bool Finish()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _finishing = true;
+                _condPending.notify_one();
+            }
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+            _stream.reset();
+            return !_failed;
+        }
+
+    private:
+        void ProcessQueue()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;)
+            {
+                _condPending.wait(lock, [this] { return _finishing || !_pending.empty(); });
+                if (_pending.empty())
+                    break;
+
+                auto chunk = std::move(_pending.front());
+                _pending.pop_front();
+
+                lock.unlock();
+                bool written = WriteChunk(chunk.first, chunk.second);
+                lock.lock();
+
+                if (!written)
+                    _failed = true;
+            }
+        }
+
+        bool WriteChunk(ReplayChunkHeader header, const MemoryStream& data)
+        {
+            unsigned long dataLength = static_cast<unsigned long>(data.GetLength());
+            unsigned long compressLength = compressBound(dataLength);
+
+            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
+            int result = compress2(
+                compressBuf.get(), &compressLength, (const unsigned char*)data.GetData(), dataLength, ReplayCompressionLevel);
+            if (result != Z_OK)
+            {
+                log_error("Unable to compress replay chunk.");
+                return false;
+            }
+
+            try
+            {
+                header.uncompressedSize = static_cast<uint32_t>(dataLength);
+                header.compressedSize = static_cast<uint32_t>(compressLength);
+
+                DataSerialiser serialiser(true, *_stream);
+                serialiser << header.type;
+                serialiser << header.tick;
+                serialiser << header.uncompressedSize;
+                serialiser << header.compressedSize;
+                _stream->Write(compressBuf.get(), compressLength);
+            }
+            catch (const std::exception& ex)
+            {
+                log_error("Unable to write replay chunk: %s", ex.what());
+                return false;
+            }
+            return true;
+        }
+
+        std::unique_ptr<IStream> _stream;
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _condPending;
+        std::deque<std::pair<ReplayChunkHeader, MemoryStream>> _pending;
+        bool _finishing = false;
+        bool _failed = false;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -108,13 +244,25 @@ namespace OpenRCT2
         std::multiset<ReplayCommand> commands;
         std::vector<std::pair<uint32_t, rct_sprite_checksum>> checksums;
         uint32_t checksumIndex;
+        std::unique_ptr<IStream> stream; // Remaining chunks of a replay being played.
+        uint32_t chunkTickStart = 0;     // First tick of the chunk being recorded.
+        uint32_t chunkTickEnd = 0;       // Tick at which the loaded chunk ends.
+        uint32_t numCommandsWritten = 0;
+        uint32_t numChecksumsWritten = 0;
+        uint32_t numKeyframesWritten = 0;
+        uint32_t keyframeTicks = 0; // Interval between keyframes while recording, 0 if disabled.
+        uint32_t nextKeyframeTick = 0;
+        uint64_t firstChunkPosition = 0;
+        std::vector<std::pair<uint32_t, uint64_t>> keyframes; // Tick and file position of each keyframe.
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 2;
+        static constexpr uint16_t ReplayVersion = 3;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
-        static constexpr int ReplayCompressionLevel = 9;
+        static constexpr uint32_t ReplayChunkTicks = 4096;
+        // Upper bound for the decompressed size read from a replay file, anything larger is treated as corrupt.
+        static constexpr uint64_t ReplayMaxUncompressedSize = 256 * 1024 * 1024;
 
         enum class ReplayMode
         {
@@ -184,6 +332,23 @@ namespace OpenRCT2
             if (_mode == ReplayMode::NONE)
                 return;
 
+            if (_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION)
+            {
+                // Hand everything recorded before this tick to the writer before anything is added for it,
+                // a keyframe always starts a new chunk so seeking can continue reading right after it.
+                auto& recording = *_currentRecording;
+                bool keyframeDue = recording.keyframeTicks != 0 && gCurrentTicks >= recording.nextKeyframeTick;
+                if (keyframeDue || gCurrentTicks - recording.chunkTickStart >= ReplayChunkTicks)
+                {
+                    WriteRecordingChunk();
+                }
+                if (keyframeDue)
+                {
+                    WriteKeyframe();
+                    recording.nextKeyframeTick = gCurrentTicks + recording.keyframeTicks;
+                }
+            }
+
             if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && gCurrentTicks == _nextChecksumTick)
             {
                 rct_sprite_checksum checksum = sprite_checksum();
@@ -202,6 +367,10 @@ namespace OpenRCT2
             }
             else if (_mode == ReplayMode::PLAYING)
             {
+                while (gCurrentTicks >= _currentReplay->chunkTickEnd && ReadNextChunk(*_currentReplay))
+                {
+                }
+
 #ifndef DISABLE_NETWORK
                 // If the network is disabled we will only get a dummy hash which will cause
                 // false positives during replay.
@@ -218,6 +387,10 @@ namespace OpenRCT2
             }
             else if (_mode == ReplayMode::NORMALISATION)
             {
+                while (_currentReplay->commands.empty() && ReadNextChunk(*_currentReplay))
+                {
+                }
+
                 ReplayCommands();
 
                 // If we run out of commands we can just stop
@@ -233,7 +406,8 @@ namespace OpenRCT2
             }
         }
 
-        virtual bool StartRecording(const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/) override
+        virtual bool StartRecording(
+            const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/, uint32_t keyframeTicks /*= 0*/) override
         {
             if (_mode != ReplayMode::NONE && _mode != ReplayMode::NORMALISATION)
                 return false;
@@ -253,20 +427,31 @@ namespace OpenRCT2
             std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
             replayData->filePath = Path::Combine(outPath, replayName);
 
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
+            SavePark(*replayData);
+            replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            auto s6exporter = std::make_unique<S6Exporter>();
-            s6exporter->ExportObjectsList = objects;
-            s6exporter->Export();
-            s6exporter->SaveGame(&replayData->parkData);
+            try
+            {
+                auto fs = std::make_unique<FileStream>(replayData->filePath, FILE_MODE_WRITE);
+                DataSerialiser fileSerialiser(true, *fs);
+                fileSerialiser << replayData->magic;
+                fileSerialiser << replayData->version;
 
-            replayData->spriteSpatialData.Write(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
-            replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
+                _chunkWriter = std::make_unique<ReplayChunkWriter>(std::move(fs));
+            }
+            catch (const std::exception& ex)
+            {
+                log_error("Unable to write to file '%s': %s", replayData->filePath.c_str(), ex.what());
+                return false;
+            }
 
-            DataSerialiser parkParams(true, replayData->parkParams);
-            SerialiseParkParameters(parkParams);
+            // The park is by far the largest part of the replay, compressing it is left to the writer as well.
+            DataSerialiser headerSerialiser(true);
+            SerialiseHeader(headerSerialiser, *replayData);
+            _chunkWriter->Enqueue(REPLAY_CHUNK_HEADER, gCurrentTicks, std::move(headerSerialiser.GetStream()));
+            replayData->chunkTickStart = gCurrentTicks;
+            replayData->keyframeTicks = keyframeTicks;
+            replayData->nextKeyframeTick = gCurrentTicks + keyframeTicks;
 
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::RECORDING;
@@ -284,48 +469,17 @@ namespace OpenRCT2
 
             _currentRecording->tickEnd = gCurrentTicks;
 
-            // Serialise Body.
-            DataSerialiser recSerialiser(true);
-            Serialise(recSerialiser, *_currentRecording);
-
-            const auto& stream = recSerialiser.GetStream();
-            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
-            unsigned long compressLength = compressBound(streamLength);
-
-            MemoryStream data(compressLength);
+            // Only the ticks since the last chunk are left to write.
+            WriteRecordingChunk();
 
-            ReplayRecordFile file{ _currentRecording->magic, _currentRecording->version, streamLength, data };
+            _chunkWriter->Enqueue(REPLAY_CHUNK_END, _currentRecording->tickEnd, MemoryStream());
 
-            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
-            compress2(
-                compressBuf.get(), &compressLength, (unsigned char*)stream.GetData(), stream.GetLength(),
-                ReplayCompressionLevel);
-            file.data.Write(compressBuf.get(), compressLength);
-
-            DataSerialiser fileSerialiser(true);
-            fileSerialiser << file.magic;
-            fileSerialiser << file.version;
-            fileSerialiser << file.uncompressedSize;
-            fileSerialiser << file.data;
-
-            bool result = false;
-
-            const std::string& outFile = _currentRecording->filePath;
-
-            FILE* fp = fopen(outFile.c_str(), "wb");
-            if (fp)
-            {
-                const auto& fileStream = fileSerialiser.GetStream();
-                fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
-                fclose(fp);
-
-                result = true;
-            }
-            else
+            bool result = _chunkWriter->Finish();
+            if (!result)
             {
-                log_error("Unable to write to file '%s'", outFile.c_str());
-                result = false;
+                log_error("Unable to write to file '%s'", _currentRecording->filePath.c_str());
             }
+            _chunkWriter.reset();
 
             // When normalizing the output we don't touch the mode.
             if (_mode != ReplayMode::NORMALISATION)
@@ -361,8 +515,9 @@ namespace OpenRCT2
                 info.Ticks = gCurrentTicks - data->tickStart;
             else if (_mode == ReplayMode::PLAYING)
                 info.Ticks = data->tickEnd - data->tickStart;
-            info.NumCommands = (uint32_t)data->commands.size();
-            info.NumChecksums = (uint32_t)data->checksums.size();
+            info.NumCommands = (uint32_t)data->commands.size() + data->numCommandsWritten;
+            info.NumChecksums = (uint32_t)data->checksums.size() + data->numChecksumsWritten;
+            info.NumKeyframes = (uint32_t)data->keyframes.size() + data->numKeyframesWritten;
 
             return true;
         }
@@ -416,6 +571,39 @@ namespace OpenRCT2
             return _faultyChecksumIndex != -1;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            auto& data = *_currentReplay;
+            uint32_t tick = data.tickStart + std::min(replayTick, data.tickEnd - data.tickStart);
+
+            // Going back needs a keyframe, going forward only if it skips ahead of the current tick.
+            if (data.stream != nullptr)
+            {
+                auto keyframe = FindKeyframe(data, tick);
+                bool keyframeAhead = keyframe != nullptr && keyframe->first > gCurrentTicks;
+                if (tick < gCurrentTicks || keyframeAhead)
+                {
+                    if (!LoadKeyframe(data, tick))
+                        return false;
+                }
+            }
+            else if (tick < gCurrentTicks)
+            {
+                log_error("Replay version %u does not support seeking backwards.", data.version);
+                return false;
+            }
+
+            auto* gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < tick)
+            {
+                gameState->UpdateLogic();
+            }
+            return true;
+        }
+
         virtual bool StopPlayback() override
         {
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
@@ -448,7 +636,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!StartRecording(outFile, k_MaxReplayTicks))
+            if (!StartRecording(outFile, k_MaxReplayTicks, 0))
             {
                 StopPlayback();
                 return false;
@@ -600,6 +788,7 @@ namespace OpenRCT2
                 std::memcpy(gSpriteSpatialIndex, data.spriteSpatialData.GetData(), data.spriteSpatialData.GetLength());
 
                 // Load all map global variables.
+                data.parkParams.SetPosition(0);
                 DataSerialiser parkParams(false, data.parkParams);
                 SerialiseParkParameters(parkParams);
 
@@ -650,12 +839,16 @@ namespace OpenRCT2
             {
                 fileSerializer << recFile.uncompressedSize;
                 fileSerializer << recFile.data;
+                if (recFile.uncompressedSize > ReplayMaxUncompressedSize)
+                {
+                    return false;
+                }
 
                 auto buff = std::make_unique<unsigned char[]>(recFile.uncompressedSize);
                 unsigned long outSize = recFile.uncompressedSize;
-                uncompress(
+                int err = uncompress(
                     (unsigned char*)buff.get(), &outSize, (unsigned char*)recFile.data.GetData(), recFile.data.GetLength());
-                if (outSize != recFile.uncompressedSize)
+                if (err != Z_OK || outSize != recFile.uncompressedSize)
                 {
                     return false;
                 }
@@ -679,18 +872,28 @@ namespace OpenRCT2
             std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
             std::string outFile = Path::Combine(outPath, fileName);
 
-            bool loaded = false;
-            if (ReadReplayFromFile(outFile, stream))
+            data.filePath = File::Exists(outFile) ? outFile : file;
+
+            try
             {
-                data.filePath = outFile;
-                loaded = true;
+                auto fs = std::make_unique<FileStream>(data.filePath, FILE_MODE_OPEN);
+                DataSerialiser fileSerialiser(false, *fs);
+                fileSerialiser << data.magic;
+                fileSerialiser << data.version;
+
+                if (data.magic == ReplayMagic && data.version >= ReplayVersion)
+                {
+                    return ReadReplayStream(std::move(fs), data);
+                }
             }
-            else if (ReadReplayFromFile(file, stream))
+            catch (const std::exception& ex)
             {
-                data.filePath = file;
-                loaded = true;
+                log_error("Unable to read replay '%s': %s", data.filePath.c_str(), ex.what());
+                return false;
             }
-            if (!loaded)
+
+            // Older versions are a single compressed block.
+            if (!ReadReplayFromFile(data.filePath, stream))
                 return false;
 
             if (!TryDecompress(stream))
@@ -711,6 +914,272 @@ namespace OpenRCT2
             return true;
         }
 
+        bool ReadReplayStream(std::unique_ptr<IStream>&& stream, ReplayRecordData& data)
+        {
+            if (data.version != ReplayVersion)
+            {
+                log_error("Invalid version detected %04X, expected: %04X", data.version, ReplayVersion);
+                return false;
+            }
+
+            ReplayChunkHeader header;
+            MemoryStream headerChunk;
+            if (!ReadChunkHeader(*stream, header) || header.type != REPLAY_CHUNK_HEADER
+                || !ReadChunkData(*stream, header, headerChunk))
+            {
+                log_error("Replay header is missing.");
+                return false;
+            }
+
+            DataSerialiser serialiser(false, headerChunk);
+            SerialiseHeader(serialiser, data);
+
+            // Look up the last tick and the keyframes without decompressing anything, an interrupted
+            // recording has no end chunk and simply plays until the data runs out.
+            data.tickEnd = k_MaxReplayTicks;
+            data.firstChunkPosition = stream->GetPosition();
+            try
+            {
+                uint64_t chunkPosition = data.firstChunkPosition;
+                while (ReadChunkHeader(*stream, header))
+                {
+                    if (header.type == REPLAY_CHUNK_END)
+                    {
+                        data.tickEnd = header.tick;
+                        break;
+                    }
+                    if (header.type == REPLAY_CHUNK_KEYFRAME)
+                    {
+                        data.keyframes.emplace_back(header.tick, chunkPosition);
+                    }
+                    stream->Seek(header.compressedSize, STREAM_SEEK_CURRENT);
+                    chunkPosition = stream->GetPosition();
+                }
+            }
+            catch (const IOException&)
+            {
+            }
+            stream->SetPosition(data.firstChunkPosition);
+
+            data.stream = std::move(stream);
+            data.chunkTickEnd = data.tickStart;
+
+            // Reset position of all streams.
+            data.parkData.SetPosition(0);
+            data.parkParams.SetPosition(0);
+            data.spriteSpatialData.SetPosition(0);
+
+            return true;
+        }
+
+        bool ReadChunkHeader(IStream& stream, ReplayChunkHeader& header)
+        {
+            if (stream.GetPosition() >= stream.GetLength())
+                return false;
+
+            DataSerialiser serialiser(false, stream);
+            serialiser << header.type;
+            serialiser << header.tick;
+            serialiser << header.uncompressedSize;
+            serialiser << header.compressedSize;
+            return true;
+        }
+
+        bool ReadChunkData(IStream& stream, const ReplayChunkHeader& header, MemoryStream& chunk)
+        {
+            if (header.uncompressedSize > ReplayMaxUncompressedSize
+                || header.compressedSize > stream.GetLength() - stream.GetPosition())
+            {
+                return false;
+            }
+
+            auto compressed = std::make_unique<unsigned char[]>(header.compressedSize);
+            stream.Read(compressed.get(), header.compressedSize);
+
+            auto buff = std::make_unique<unsigned char[]>(header.uncompressedSize);
+            unsigned long outSize = header.uncompressedSize;
+            int err = uncompress(buff.get(), &outSize, compressed.get(), header.compressedSize);
+            if (err != Z_OK || outSize != header.uncompressedSize)
+            {
+                return false;
+            }
+            chunk.Write(buff.get(), outSize);
+            chunk.SetPosition(0);
+            return true;
+        }
+
+        /**
+         * Loads the commands and checksums of the next chunk of a replay that is being played.
+         * @return false once there are no chunks left.
+         */
+        bool ReadNextChunk(ReplayRecordData& data)
+        {
+            if (data.stream == nullptr)
+                return false;
+
+            try
+            {
+                ReplayChunkHeader header;
+                while (ReadChunkHeader(*data.stream, header))
+                {
+                    if (header.type == REPLAY_CHUNK_END)
+                    {
+                        data.tickEnd = header.tick;
+                        break;
+                    }
+                    if (header.type != REPLAY_CHUNK_TICKS)
+                    {
+                        data.stream->Seek(header.compressedSize, STREAM_SEEK_CURRENT);
+                        continue;
+                    }
+
+                    MemoryStream chunk;
+                    if (!ReadChunkData(*data.stream, header, chunk))
+                    {
+                        log_error("Replay chunk is corrupt.");
+                        break;
+                    }
+
+                    data.checksums.clear();
+                    data.checksumIndex = 0;
+                    data.chunkTickEnd = header.tick;
+
+                    DataSerialiser serialiser(false, chunk);
+                    SerialiseCommands(serialiser, data);
+                    SerialiseChecksums(serialiser, data);
+
+                    if (!TranslateDeprecatedGameCommands(data))
+                    {
+                        log_error("Unable to translate deprecated game commands.");
+                        break;
+                    }
+                    return true;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                log_error("Unable to read replay chunk: %s", ex.what());
+            }
+
+            // Keep the file open for seeking, but don't read past the end again.
+            data.tickEnd = std::min(data.tickEnd, data.chunkTickEnd);
+            data.stream->SetPosition(data.stream->GetLength());
+            return false;
+        }
+
+        /**
+         * Restores the park from the last keyframe at or before the given tick, or from the start of the
+         * replay if there is none, and continues reading the chunks that follow it.
+         */
+        bool LoadKeyframe(ReplayRecordData& data, uint32_t tick)
+        {
+            auto it = FindKeyframe(data, tick);
+
+            uint32_t keyframeTick = data.tickStart;
+            try
+            {
+                if (it == nullptr)
+                {
+                    if (!LoadReplayDataMap(data))
+                        return false;
+
+                    data.stream->SetPosition(data.firstChunkPosition);
+                }
+                else
+                {
+                    keyframeTick = it->first;
+                    data.stream->SetPosition(it->second);
+
+                    ReplayChunkHeader header;
+                    MemoryStream chunk;
+                    if (!ReadChunkHeader(*data.stream, header) || header.type != REPLAY_CHUNK_KEYFRAME
+                        || !ReadChunkData(*data.stream, header, chunk))
+                    {
+                        log_error("Replay keyframe at tick %u is corrupt.", keyframeTick);
+                        return false;
+                    }
+
+                    ReplayRecordData keyframe;
+                    DataSerialiser serialiser(false, chunk);
+                    SerialiseKeyframe(serialiser, keyframe);
+                    if (!LoadReplayDataMap(keyframe))
+                        return false;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                log_error("Unable to read replay keyframe: %s", ex.what());
+                return false;
+            }
+
+            gCurrentTicks = keyframeTick;
+            gGamePaused = 0;
+
+            data.commands.clear();
+            data.checksums.clear();
+            data.checksumIndex = 0;
+            data.chunkTickEnd = keyframeTick;
+            _faultyChecksumIndex = -1;
+
+            return true;
+        }
+
+        const std::pair<uint32_t, uint64_t>* FindKeyframe(const ReplayRecordData& data, uint32_t tick) const
+        {
+            auto it = std::upper_bound(
+                data.keyframes.begin(), data.keyframes.end(), tick,
+                [](uint32_t t, const std::pair<uint32_t, uint64_t>& keyframe) { return t < keyframe.first; });
+            if (it == data.keyframes.begin())
+                return nullptr;
+            return &*std::prev(it);
+        }
+
+        void SavePark(ReplayRecordData& data)
+        {
+            auto context = GetContext();
+            auto& objManager = context->GetObjectManager();
+            auto objects = objManager.GetPackableObjects();
+
+            auto s6exporter = std::make_unique<S6Exporter>();
+            s6exporter->ExportObjectsList = objects;
+            s6exporter->Export();
+            s6exporter->SaveGame(&data.parkData);
+
+            data.spriteSpatialData.Write(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
+
+            DataSerialiser parkParams(true, data.parkParams);
+            SerialiseParkParameters(parkParams);
+        }
+
+        void WriteKeyframe()
+        {
+            ReplayRecordData keyframe;
+            SavePark(keyframe);
+
+            DataSerialiser serialiser(true);
+            SerialiseKeyframe(serialiser, keyframe);
+            _chunkWriter->Enqueue(REPLAY_CHUNK_KEYFRAME, gCurrentTicks, std::move(serialiser.GetStream()));
+
+            _currentRecording->numKeyframesWritten++;
+        }
+
+        void WriteRecordingChunk()
+        {
+            auto& data = *_currentRecording;
+            data.chunkTickEnd = gCurrentTicks;
+
+            DataSerialiser serialiser(true);
+            SerialiseCommands(serialiser, data);
+            SerialiseChecksums(serialiser, data);
+            _chunkWriter->Enqueue(REPLAY_CHUNK_TICKS, data.chunkTickEnd, std::move(serialiser.GetStream()));
+
+            data.numCommandsWritten += (uint32_t)data.commands.size();
+            data.numChecksumsWritten += (uint32_t)data.checksums.size();
+            data.commands.clear();
+            data.checksums.clear();
+            data.chunkTickStart = gCurrentTicks;
+        }
+
         bool SerialiseParkParameters(DataSerialiser& serialiser)
         {
             serialiser << _guestGenerationProbability;
@@ -785,7 +1254,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == 1 && ReplayVersion == 2;
+            return data.version == 1 || data.version == 2;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -803,10 +1272,20 @@ namespace OpenRCT2
                 return false;
             }
 
+            SerialiseHeader(serialiser, data);
+            serialiser << data.tickEnd;
+            SerialiseCommands(serialiser, data);
+            SerialiseChecksums(serialiser, data);
+
+            return true;
+        }
+
+        void SerialiseHeader(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
             serialiser << data.networkId;
 #ifndef DISABLE_NETWORK
             // NOTE: This does not mean the replay will not function, only a warning.
-            if (data.networkId != network_get_version())
+            if (serialiser.IsLoading() && data.networkId != network_get_version())
             {
                 log_warning(
                     "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
@@ -816,12 +1295,19 @@ namespace OpenRCT2
 
             serialiser << data.name;
             serialiser << data.timeRecorded;
+            SerialiseKeyframe(serialiser, data);
+            serialiser << data.tickStart;
+        }
+
+        void SerialiseKeyframe(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
             serialiser << data.parkData;
             serialiser << data.parkParams;
             serialiser << data.spriteSpatialData;
-            serialiser << data.tickStart;
-            serialiser << data.tickEnd;
+        }
 
+        void SerialiseCommands(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
             uint32_t countCommands = (uint32_t)data.commands.size();
             serialiser << countCommands;
 
@@ -842,7 +1328,10 @@ namespace OpenRCT2
                     data.commands.emplace(std::move(command));
                 }
             }
+        }
 
+        void SerialiseChecksums(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
             uint32_t countChecksums = (uint32_t)data.checksums.size();
             serialiser << countChecksums;
 
@@ -856,8 +1345,6 @@ namespace OpenRCT2
                 serialiser << data.checksums[i].first;
                 serialiser << data.checksums[i].second.raw;
             }
-
-            return true;
         }
 
 #ifndef DISABLE_NETWORK
@@ -965,6 +1452,7 @@ namespace OpenRCT2
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        std::unique_ptr<ReplayChunkWriter> _chunkWriter;
     };
 
     std::unique_ptr<IReplayManager> CreateReplayManager()
@@ -28,6 +28,7 @@ namespace OpenRCT2
         uint64_t TimeRecorded;
         uint32_t NumCommands;
         uint32_t NumChecksums;
+        uint32_t NumKeyframes;
         std::string Name;
         std::string FilePath;
     };
@@ -50,12 +51,14 @@ namespace OpenRCT2
             = 0;
         virtual void AddGameAction(uint32_t tick, const GameAction* action) = 0;
 
-        virtual bool StartRecording(const std::string& name, uint32_t maxTicks = k_MaxReplayTicks) = 0;
+        virtual bool StartRecording(
+            const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, uint32_t keyframeTicks = 0) = 0;
         virtual bool StopRecording() = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo & info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
         virtual bool StopPlayback() = 0;
 
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
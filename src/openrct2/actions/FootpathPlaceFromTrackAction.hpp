@@ -274,6 +274,7 @@ private:
                 pathElement->SetGhost(true);
             }
             map_invalidate_tile_full(_loc.x, _loc.y);
+            map_queue_path_wide_flags_update(_loc.x, _loc.y);
         }
 
         // Prevent the place sound from being spammed
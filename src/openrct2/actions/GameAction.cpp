@@ -18,6 +18,7 @@
 #include "../network/network.h"
 #include "../platform/platform.h"
 #include "../scenario/Scenario.h"
+#include "../world/Map.h"
 #include "../world/Park.h"
 
 #include <algorithm>
@@ -284,8 +285,11 @@ namespace GameActions
             ActionLogContext_t logContext;
             LogActionBegin(logContext, action);
 
-            // Execute the action, changing the game state
+            // Execute the action, changing the game state. Ghosts are ignored by the tile updates, so they do not
+            // make any tile busy again.
+            bool trackedIdleTiles = map_track_idle_tile_changes(!(flags & GAME_COMMAND_FLAG_GHOST));
             result = action->Execute();
+            map_track_idle_tile_changes(trackedIdleTiles);
 
             LogActionFinish(logContext, action, result);
 
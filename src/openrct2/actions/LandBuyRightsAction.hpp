@@ -149,6 +149,7 @@ private:
                 if (isExecuting)
                 {
                     surfaceElement->SetOwnership(OWNERSHIP_OWNED);
+                    park_update_size_at(loc);
                     update_park_fences_around_tile(loc);
                 }
                 res->Cost = gLandPrice;
@@ -169,6 +170,7 @@ private:
                 if (isExecuting)
                 {
                     surfaceElement->SetOwnership(surfaceElement->GetOwnership() | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
+                    park_update_size_at(loc);
                     uint16_t baseHeight = surfaceElement->base_height * 8;
                     map_invalidate_tile(loc.x, loc.y, baseHeight, baseHeight + 16);
                 }
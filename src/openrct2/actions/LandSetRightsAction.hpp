@@ -145,6 +145,7 @@ private:
                 {
                     surfaceElement->SetOwnership(
                         surfaceElement->GetOwnership() & ~(OWNERSHIP_OWNED | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED));
+                    park_update_size_at(loc);
                     update_park_fences_around_tile(loc);
                 }
                 return res;
@@ -152,6 +153,7 @@ private:
                 if (isExecuting)
                 {
                     surfaceElement->SetOwnership(surfaceElement->GetOwnership() & ~OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
+                    park_update_size_at(loc);
                     uint16_t baseHeight = surfaceElement->base_height * 8;
                     map_invalidate_tile(loc.x, loc.y, baseHeight, baseHeight + 16);
                 }
@@ -220,6 +222,7 @@ private:
                             gPeepSpawns.end());
                     }
                     surfaceElement->SetOwnership(_ownership);
+                    park_update_size_at(loc);
                     update_park_fences_around_tile(loc);
                     gMapLandRightsUpdateSuccess = true;
                 }
@@ -152,6 +152,7 @@ public:
             {
                 SurfaceElement* surfaceElement = map_get_surface_element_at(entranceLoc)->AsSurface();
                 surfaceElement->SetOwnership(OWNERSHIP_UNOWNED);
+                park_update_size_at({ entranceLoc.x, entranceLoc.y });
             }
 
             TileElement* newElement = tile_element_insert(entranceLoc.x / 32, entranceLoc.y / 32, zLow, 0xF);
@@ -759,6 +759,7 @@ private:
                 if (destOwnership != OWNERSHIP_UNOWNED)
                 {
                     surfaceElement->AsSurface()->SetOwnership(destOwnership);
+                    park_update_size_at(coords);
                     update_park_fences_around_tile(coords);
                     uint16_t baseHeight = surfaceElement->base_height * 8;
                     map_invalidate_tile(coords.x, coords.y, baseHeight, baseHeight + 16);
@@ -775,6 +776,7 @@ private:
             {
                 TileElement* surfaceElement = map_get_surface_element_at({ x, y });
                 surfaceElement->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
+                park_update_size_at({ x, y });
                 update_park_fences_around_tile({ x, y });
                 uint16_t baseHeight = surfaceElement->base_height * 8;
                 map_invalidate_tile(x, y, baseHeight, baseHeight + 16);
@@ -254,6 +254,7 @@ private:
             newPeep->energy_target = 0x60;
             newPeep->staff_mowing_timeout = 0;
 
+            // Also adds the new staff member to the staff index, in its place in the peep list.
             peep_update_name_sort(newPeep);
 
             newPeep->staff_id = staffIndex;
@@ -0,0 +1,274 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../core/Console.hpp"
+#include "../network/NetworkLoadTest.h"
+#include "../network/network.h"
+#include "../object/ObjectLimits.h"
+#include "../platform/platform.h"
+#include "../world/Map.h"
+#include "../world/SmallScenery.h"
+#include "../world/Surface.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::LoadTestCommands[]{
+    // Main commands
+    DefineCommand("", "<sv6-file> <clients> <seconds> [<port>]", nullptr, HandleLoadTest), CommandTableEnd
+};
+
+#ifndef DISABLE_NETWORK
+
+// How long to wait for all clients to join before measuring anyway.
+constexpr uint32_t LOADTEST_JOIN_TIMEOUT = 120000;
+constexpr size_t LOADTEST_TILES_PER_CLIENT = 8;
+
+static NetworkLoadTestWorkload CreateWorkload(size_t numClients)
+{
+    NetworkLoadTestWorkload workload;
+    for (int32_t i = 0; i < MAX_SMALL_SCENERY_OBJECTS; i++)
+    {
+        auto sceneryEntry = get_small_scenery_entry(i);
+        if (sceneryEntry != nullptr && scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_FULL_TILE))
+        {
+            workload.SceneryType = (uint8_t)i;
+            break;
+        }
+    }
+    if (workload.SceneryType == 0xFF)
+    {
+        return workload;
+    }
+
+    // Only use flat, owned tiles with nothing on them, so placing and removing the scenery can succeed.
+    size_t maxTiles = numClients * LOADTEST_TILES_PER_CLIENT;
+    for (int32_t y = 1; y < gMapSize - 1 && workload.SceneryTiles.size() < maxTiles; y++)
+    {
+        for (int32_t x = 1; x < gMapSize - 1 && workload.SceneryTiles.size() < maxTiles; x++)
+        {
+            auto tileElement = map_get_first_element_at(x, y);
+            if (tileElement == nullptr || tileElement->GetType() != TILE_ELEMENT_TYPE_SURFACE || !tileElement->IsLastForTile())
+            {
+                continue;
+            }
+
+            auto surfaceElement = tileElement->AsSurface();
+            if ((surfaceElement->GetOwnership() & OWNERSHIP_OWNED) && surfaceElement->GetSlope() == TILE_ELEMENT_SLOPE_FLAT
+                && surfaceElement->GetWaterHeight() == 0)
+            {
+                workload.SceneryTiles.push_back({ (int16_t)(x * 32), (int16_t)(y * 32), tileElement->base_height });
+            }
+        }
+    }
+    return workload;
+}
+
+// Lets the synthetic players use every game action, new players usually join as spectators.
+static void PromotePlayers()
+{
+    int32_t groupIndex = network_get_group_index(0);
+    if (groupIndex == -1)
+    {
+        return;
+    }
+
+    for (int32_t i = 0; i < network_get_num_players(); i++)
+    {
+        if (!(network_get_player_flags(i) & NETWORK_PLAYER_FLAG_ISSERVER) && network_get_player_group(i) != 0)
+        {
+            network_set_player_group(i, groupIndex);
+        }
+    }
+}
+
+static uint32_t GetPercentile(std::vector<uint32_t>& values, uint32_t percentile)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, values.size() * percentile / 100)];
+}
+
+static double GetAverage(const std::vector<uint32_t>& values)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    double sum = 0;
+    for (auto value : values)
+    {
+        sum += value;
+    }
+    return sum / values.size();
+}
+
+static void PrintReport(
+    std::vector<NetworkLoadTestClientResult>& results, std::vector<uint32_t>& tickTimes, uint32_t measuredTime)
+{
+    Console::WriteLine(
+        "%-12s %8s %11s %11s %8s %8s %8s %10s %10s", "client", "join ms", "actions", "chats", "avg ms", "p95 ms", "max ms",
+        "recv KiB", "sent KiB");
+
+    std::vector<uint32_t> allLatencies;
+    uint64_t totalReceived = 0;
+    uint64_t totalSent = 0;
+    for (auto& result : results)
+    {
+        if (!result.Joined)
+        {
+            Console::WriteLine("%-12s failed: %s", result.Name.c_str(), result.Error.c_str());
+            continue;
+        }
+
+        uint64_t received = result.Stats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL];
+        uint64_t sent = result.Stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL];
+        totalReceived += result.MeasuredBytesReceived;
+        totalSent += result.MeasuredBytesSent;
+        allLatencies.insert(allLatencies.end(), result.Latencies.begin(), result.Latencies.end());
+
+        Console::WriteLine(
+            "%-12s %8u %5u/%-5u %5u/%-5u %8.1f %8u %8u %10.1f %10.1f", result.Name.c_str(), result.JoinTime,
+            result.ActionsConfirmed, result.ActionsSent, result.ChatsConfirmed, result.ChatsSent,
+            GetAverage(result.Latencies), GetPercentile(result.Latencies, 95), GetPercentile(result.Latencies, 100),
+            received / 1024.0, sent / 1024.0);
+    }
+
+    double seconds = std::max(measuredTime, 1u) / 1000.0;
+    Console::WriteLine();
+    Console::WriteLine(
+        "Latency:      avg %.1f ms, p95 %u ms, p99 %u ms, max %u ms", GetAverage(allLatencies),
+        GetPercentile(allLatencies, 95), GetPercentile(allLatencies, 99), GetPercentile(allLatencies, 100));
+    Console::WriteLine(
+        "Server tick:  avg %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms over %u ticks", GetAverage(tickTimes) / 1000.0,
+        GetPercentile(tickTimes, 95) / 1000.0, GetPercentile(tickTimes, 99) / 1000.0, GetPercentile(tickTimes, 100) / 1000.0,
+        (uint32_t)tickTimes.size());
+    Console::WriteLine(
+        "Bandwidth:    %.1f KiB/s to clients, %.1f KiB/s from clients", totalReceived / 1024.0 / seconds,
+        totalSent / 1024.0 / seconds);
+}
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 3)
+    {
+        Console::Error::WriteLine("Missing arguments <sv6-file> <clients> <seconds>.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    const char* inputPath = argv[0];
+    size_t numClients = (size_t)std::max(atol(argv[1]), 1L);
+    uint32_t measureTime = (uint32_t)atol(argv[2]) * 1000;
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+    if (!context->LoadParkFromFile(inputPath))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    int32_t port = argc >= 4 ? atoi(argv[3]) : gConfigNetwork.default_port;
+    gConfigNetwork.maxplayers = std::max<int32_t>(gConfigNetwork.maxplayers, (int32_t)numClients + 1);
+    gConfigNetwork.known_keys_only = false;
+    network_set_password("");
+    if (!network_begin_server(port, "127.0.0.1"))
+    {
+        Console::Error::WriteLine("Unable to start the server on port %d.", port);
+        return EXITCODE_FAIL;
+    }
+
+    auto workload = CreateWorkload(numClients);
+    Console::WriteLine(
+        "Connecting %u clients to port %d, %u tiles available for scenery...", (uint32_t)numClients, port,
+        (uint32_t)workload.SceneryTiles.size());
+
+    auto gameState = context->GetGameState();
+    NetworkLoadTest loadTest("127.0.0.1", port, numClients, workload);
+
+    std::vector<uint32_t> tickTimes;
+    uint32_t startTime = platform_get_ticks();
+    uint32_t measureStartTime = 0;
+    bool measuring = false;
+    for (;;)
+    {
+        auto tickStart = std::chrono::high_resolution_clock::now();
+        gameState->UpdateLogic();
+        auto tickEnd = std::chrono::high_resolution_clock::now();
+        PromotePlayers();
+
+        uint32_t now = platform_get_ticks();
+        if (measuring)
+        {
+            tickTimes.push_back(
+                (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(tickEnd - tickStart).count());
+            if (now - measureStartTime >= measureTime)
+            {
+                break;
+            }
+        }
+        else if (loadTest.GetNumJoined() + loadTest.GetNumFailed() >= numClients || now - startTime >= LOADTEST_JOIN_TIMEOUT)
+        {
+            Console::WriteLine(
+                "%u clients joined, %u failed, measuring for %u seconds...", (uint32_t)loadTest.GetNumJoined(),
+                (uint32_t)loadTest.GetNumFailed(), measureTime / 1000);
+            measuring = true;
+            measureStartTime = now;
+            loadTest.BeginMeasuring();
+        }
+
+        // Run at the regular game speed so that the clients see realistic tick and ping rates.
+        auto tickDuration = std::chrono::high_resolution_clock::now() - tickStart;
+        auto tickInterval = std::chrono::milliseconds(GAME_UPDATE_TIME_MS);
+        if (tickDuration < tickInterval)
+        {
+            std::this_thread::sleep_for(tickInterval - tickDuration);
+        }
+    }
+
+    uint32_t measuredTime = platform_get_ticks() - measureStartTime;
+    auto results = loadTest.Stop();
+    PrintReport(results, tickTimes, measuredTime);
+    return EXITCODE_OK;
+}
+
+#else
+
+static exitcode_t HandleLoadTest([[maybe_unused]] CommandLineArgEnumerator* argEnumerator)
+{
+    Console::Error::WriteLine("This build has no network support.");
+    return EXITCODE_FAIL;
+}
+
+#endif // DISABLE_NETWORK
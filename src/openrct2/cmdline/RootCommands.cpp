@@ -40,6 +40,7 @@ int32_t gNetworkStart = NETWORK_MODE_NONE;
 std::string gNetworkStartHost;
 int32_t gNetworkStartPort = NETWORK_DEFAULT_PORT;
 std::string gNetworkStartAddress;
+int32_t gNetworkStartRelayPort = 0;
 
 static uint32_t _port = 0;
 static char* _address = nullptr;
@@ -90,6 +91,7 @@ static exitcode_t HandleCommandIntro(CommandLineArgEnumerator * enumerator);
 #ifndef DISABLE_NETWORK
 static exitcode_t HandleCommandHost(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandJoin(CommandLineArgEnumerator * enumerator);
+static exitcode_t HandleCommandRelay(CommandLineArgEnumerator * enumerator);
 #endif
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandScanObjects(CommandLineArgEnumerator * enumerator);
@@ -125,6 +127,7 @@ const CommandLineCommand CommandLine::RootCommands[]
 #ifndef DISABLE_NETWORK
     DefineCommand("host",     "<uri>",                  StandardOptions, HandleCommandHost   ),
     DefineCommand("join",     "<hostname>",             StandardOptions, HandleCommandJoin   ),
+    DefineCommand("relay",    "<hostname> <port>",      StandardOptions, HandleCommandRelay  ),
 #endif
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
@@ -141,6 +144,7 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("loadtest",        CommandLine::LoadTestCommands         ),
     CommandTableEnd
 };
 
@@ -154,6 +158,7 @@ const CommandLineExample CommandLine::RootExamples[]
 #endif
 #ifndef DISABLE_NETWORK
     { "host ./my_park.sv6 --port 11753 --headless",   "run a headless server for a saved park" },
+    { "relay example.com 11754 --headless",           "relay a server to spectators on port 11754" },
 #endif
     ExampleTableEnd
 };
@@ -331,6 +336,37 @@ exitcode_t HandleCommandJoin(CommandLineArgEnumerator* enumerator)
     return EXITCODE_CONTINUE;
 }
 
+exitcode_t HandleCommandRelay(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    const char* hostname;
+    if (!enumerator->TryPopString(&hostname))
+    {
+        Console::Error::WriteLine("Expected a hostname or IP address to the server to relay.");
+        return EXITCODE_FAIL;
+    }
+
+    int32_t relayPort;
+    if (!enumerator->TryPopInteger(&relayPort) || relayPort <= 0 || relayPort > UINT16_MAX)
+    {
+        Console::Error::WriteLine("Expected a port to listen on for spectators.");
+        return EXITCODE_FAIL;
+    }
+
+    // The relay joins the server as a regular client, --port and --address apply to the server and the spectators.
+    gNetworkStart = NETWORK_MODE_CLIENT;
+    gNetworkStartPort = _port;
+    gNetworkStartHost = hostname;
+    gNetworkStartAddress = String::ToStd(_address);
+    gNetworkStartRelayPort = relayPort;
+    return EXITCODE_CONTINUE;
+}
+
 #endif // DISABLE_NETWORK
 
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator* enumerator)
@@ -391,6 +391,7 @@ namespace Config
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->desync_debugging = reader->GetBoolean("desync_debugging", false);
+            model->stats_dump_interval = reader->GetInt32("stats_dump_interval", 0);
         }
     }
 
@@ -417,6 +418,7 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
         writer->WriteBoolean("desync_debugging", model->desync_debugging);
+        writer->WriteInt32("stats_dump_interval", model->stats_dump_interval);
     }
 
     static void ReadNotifications(IIniReader* reader)
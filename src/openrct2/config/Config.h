@@ -156,6 +156,7 @@ struct NetworkConfiguration
     bool log_server_actions;
     bool pause_server_if_no_clients;
     bool desync_debugging;
+    int32_t stats_dump_interval;
 };
 
 struct NotificationConfiguration
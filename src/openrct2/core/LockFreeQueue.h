@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/**
+ * Unbounded queue which can be used without locking by exactly one thread pushing and one thread popping.
+ */
+template<typename _TType> class LockFreeQueue
+{
+private:
+    struct Node
+    {
+        _TType Value{};
+        std::atomic<Node*> Next{ nullptr };
+    };
+
+    // The head is always a node that has already been popped, only touched by the consumer.
+    Node* _head;
+    // Only touched by the producer.
+    Node* _tail;
+
+public:
+    LockFreeQueue()
+    {
+        _head = _tail = new Node();
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    ~LockFreeQueue()
+    {
+        while (_head != nullptr)
+        {
+            Node* next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    void Push(_TType&& value)
+    {
+        Node* node = new Node();
+        node->Value = std::move(value);
+        _tail->Next.store(node, std::memory_order_release);
+        _tail = node;
+    }
+
+    void Push(const _TType& value)
+    {
+        Push(_TType(value));
+    }
+
+    bool TryPop(_TType& value)
+    {
+        Node* next = _head->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        value = std::move(next->Value);
+        next->Value = _TType();
+        delete _head;
+        _head = next;
+        return true;
+    }
+};
@@ -0,0 +1,139 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Queue backed by a contiguous ring of elements which doubles in size when full. Unlike CircularBuffer it never
+ * overwrites elements, and unlike std::list it does not allocate for every element pushed.
+ */
+template<typename _TType> class RingBuffer
+{
+public:
+    typedef _TType value_type;
+    typedef _TType& reference;
+    typedef const _TType& const_reference;
+    typedef size_t size_type;
+
+    reference front()
+    {
+        return _elements[_head];
+    }
+
+    const_reference front() const
+    {
+        return _elements[_head];
+    }
+
+    reference back()
+    {
+        return (*this)[_size - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[_size - 1];
+    }
+
+    reference operator[](size_type idx)
+    {
+        return _elements[(_head + idx) & (capacity() - 1)];
+    }
+
+    const_reference operator[](size_type idx) const
+    {
+        return _elements[(_head + idx) & (capacity() - 1)];
+    }
+
+    void clear()
+    {
+        while (!empty())
+        {
+            pop_front();
+        }
+        _head = 0;
+    }
+
+    size_type size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    size_type capacity() const
+    {
+        return _elements.size();
+    }
+
+    void push_back(value_type&& val)
+    {
+        if (_size == capacity())
+        {
+            Grow();
+        }
+        _size++;
+        back() = std::move(val);
+    }
+
+    void push_back(const value_type& val)
+    {
+        push_back(value_type(val));
+    }
+
+    void push_front(value_type&& val)
+    {
+        if (_size == capacity())
+        {
+            Grow();
+        }
+        _head = (_head + capacity() - 1) & (capacity() - 1);
+        _size++;
+        front() = std::move(val);
+    }
+
+    void push_front(const value_type& val)
+    {
+        push_front(value_type(val));
+    }
+
+    void pop_front()
+    {
+        // Release whatever the element holds on to straight away.
+        front() = value_type();
+        _head = (_head + 1) & (capacity() - 1);
+        _size--;
+    }
+
+private:
+    // Capacity is always a power of two so indices can wrap with a mask.
+    static constexpr size_t InitialCapacity = 16;
+
+    std::vector<_TType> _elements;
+    size_t _head = 0;
+    size_t _size = 0;
+
+    void Grow()
+    {
+        std::vector<_TType> elements(capacity() == 0 ? InitialCapacity : capacity() * 2);
+        for (size_t i = 0; i < _size; i++)
+        {
+            elements[i] = std::move((*this)[i]);
+        }
+        _elements = std::move(elements);
+        _head = 0;
+    }
+};
@@ -1378,7 +1378,7 @@ static int32_t cc_replay_startrecord(InteractiveConsole& console, const argument
 
     if (argv.size() < 1)
     {
-        console.WriteFormatLine("Parameters required <replay_name> [<max_ticks = 0xFFFFFFFF>]");
+        console.WriteFormatLine("Parameters required <replay_name> [<max_ticks = 0xFFFFFFFF>] [<keyframe_ticks = 0>]");
         return 0;
     }
 
@@ -1391,8 +1391,15 @@ static int32_t cc_replay_startrecord(InteractiveConsole& console, const argument
         maxTicks = atol(argv[1].c_str());
     }
 
+    // Keyframes allow seeking during playback at the cost of a larger replay.
+    uint32_t keyframeTicks = 0;
+    if (argv.size() >= 3)
+    {
+        keyframeTicks = atol(argv[2].c_str());
+    }
+
     auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
-    if (replayManager->StartRecording(name, maxTicks))
+    if (replayManager->StartRecording(name, maxTicks, keyframeTicks))
     {
         OpenRCT2::ReplayRecordInfo info;
         replayManager->GetCurrentReplayInfo(info);
@@ -1473,11 +1480,40 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
                              "  Date Recorded: %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
+
+        console.WriteFormatLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
+        log_info(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
 
-        console.WriteFormatLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
-        log_info(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
 
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay at tick %u", tick);
         return 1;
     }
 
@@ -1529,6 +1565,86 @@ static int32_t cc_replay_normalise(InteractiveConsole& console, const arguments_
     return 0;
 }
 
+static void console_write_histogram(InteractiveConsole& console, const char* name, const NetworkHistogram_t& histogram)
+{
+    double average = histogram.count == 0 ? 0.0 : (double)histogram.sum / histogram.count;
+    console.WriteFormatLine(
+        "%s: %llu samples, avg %.1f, max %u", name, (unsigned long long)histogram.count, average, histogram.max);
+    for (size_t i = 0; i < NETWORK_HISTOGRAM_BUCKETS; i++)
+    {
+        if (histogram.buckets[i] == 0)
+        {
+            continue;
+        }
+        if (i < NETWORK_HISTOGRAM_BUCKETS - 1)
+        {
+            console.WriteFormatLine(
+                "  < %5u: %llu", NetworkHistogram_t::GetBucketLimit(i), (unsigned long long)histogram.buckets[i]);
+        }
+        else
+        {
+            console.WriteFormatLine(
+                "  >= %4u: %llu", NetworkHistogram_t::GetBucketLimit(i - 1), (unsigned long long)histogram.buckets[i]);
+        }
+    }
+}
+
+static int32_t cc_network_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() == NETWORK_MODE_NONE)
+    {
+        console.WriteLineError("Not in a multiplayer game.");
+        return 1;
+    }
+
+    if (argv.size() >= 1 && argv[0] == "dump")
+    {
+        auto path = network_dump_stats();
+        if (path.empty())
+        {
+            console.WriteLineError("Unable to write network stats.");
+            return 1;
+        }
+        console.WriteFormatLine("Network stats written to %s", path.c_str());
+    }
+    else if (argv.size() >= 1 && argv[0] == "connections")
+    {
+        console.WriteFormatLine(
+            "%-24s %10s %10s %8s %8s %8s", "Connection", "Recv KiB", "Sent KiB", "Queue", "Ping", "Max ping");
+        for (const auto& connectionStats : network_get_connection_stats())
+        {
+            const auto& stats = connectionStats.second;
+            double queueDepth = stats.sendQueueDepth.count == 0 ? 0.0
+                                                                : (double)stats.sendQueueDepth.sum / stats.sendQueueDepth.count;
+            double ping = stats.roundTripTime.count == 0 ? 0.0 : (double)stats.roundTripTime.sum / stats.roundTripTime.count;
+            console.WriteFormatLine(
+                "%-24s %10.1f %10.1f %8.1f %8.1f %8u", connectionStats.first.c_str(),
+                stats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL] / 1024.0,
+                stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL] / 1024.0, queueDepth, ping, stats.roundTripTime.max);
+        }
+    }
+    else
+    {
+        auto stats = network_get_stats();
+        console.WriteFormatLine("%-18s %10s %10s %10s %10s", "Command", "Recv", "Recv KiB", "Sent", "Sent KiB");
+        for (int32_t i = 0; i < NETWORK_COMMAND_MAX; i++)
+        {
+            const auto& commandStats = stats.commands[i];
+            if (commandStats.packetsReceived == 0 && commandStats.packetsSent == 0)
+            {
+                continue;
+            }
+            console.WriteFormatLine(
+                "%-18s %10llu %10.1f %10llu %10.1f", network_get_command_name(i),
+                (unsigned long long)commandStats.packetsReceived, commandStats.bytesReceived / 1024.0,
+                (unsigned long long)commandStats.packetsSent, commandStats.bytesSent / 1024.0);
+        }
+        console_write_histogram(console, "Send queue depth (packets)", stats.sendQueueDepth);
+        console_write_histogram(console, "Round trip time (ms)", stats.roundTripTime);
+    }
+    return 0;
+}
+
 static int32_t cc_mp_desync(InteractiveConsole& console, const arguments_t& argv)
 {
     int32_t desyncType = 0;
@@ -1703,11 +1819,13 @@ static constexpr const console_command console_command_table[] = {
     { "twitch", cc_twitch, "Twitch API", "twitch" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
-    { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks]"},
+    { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks] [keyframe_ticks]"},
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord"},
     { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>"},
+    { "replay_seek", cc_replay_seek, "Seeks the replay to a tick", "replay_seek <tick>"},
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop"},
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps", "replay_normalise <input file> <output file>"},
+    { "network_stats", cc_network_stats, "Shows network traffic per command, send queue depths and round trip times.", "network_stats [connections|dump]"},
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync", "cc_mp_desync [desync_type, 0 = Random t-shirt color on random peep, 1 = Remove random peep ]"},
     
 };
@@ -9,6 +9,7 @@
 
 #include "LanguagePack.h"
 
+#include "../Version.h"
 #include "../common.h"
 #include "../core/FileStream.hpp"
 #include "../core/Memory.hpp"
@@ -20,6 +21,7 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #ifndef _WIN32
 #    include <unicode/ubidi.h>
@@ -41,13 +43,52 @@ constexpr int32_t ObjectOverrideMaxStringCount = 3;
 constexpr rct_string_id ScenarioOverrideBase = 0x7000;
 constexpr int32_t ScenarioOverrideMaxStringCount = 3;
 
+constexpr uint32_t COMPILED_LANGUAGE_MAGIC = 0x4B504C4F; // OLPK
+constexpr uint16_t COMPILED_LANGUAGE_VERSION = 1;
+constexpr uint32_t STRING_OFFSET_NONE = 0xFFFFFFFF;
+
+#pragma pack(push, 1)
+/**
+ * Header of a compiled language pack. It is followed by the string offsets, the object overrides,
+ * the scenario overrides and finally the null terminated string data the offsets point into.
+ */
+struct CompiledLanguageHeader
+{
+    uint32_t MagicNumber = COMPILED_LANGUAGE_MAGIC;
+    uint16_t Version = COMPILED_LANGUAGE_VERSION;
+    uint16_t LanguageId = 0;
+    uint64_t SourceSize = 0;
+    uint64_t SourceHash = 0;
+    uint32_t BuildChecksum = 0;
+    uint32_t NumStrings = 0;
+    uint32_t NumObjectOverrides = 0;
+    uint32_t NumScenarioOverrides = 0;
+    uint32_t StringDataSize = 0;
+};
+assert_struct_size(CompiledLanguageHeader, 44);
+
 struct ObjectOverride
 {
     char name[8] = { 0 };
-    std::string strings[ObjectOverrideMaxStringCount];
+    uint32_t strings[ObjectOverrideMaxStringCount] = { STRING_OFFSET_NONE, STRING_OFFSET_NONE, STRING_OFFSET_NONE };
 };
+assert_struct_size(ObjectOverride, 20);
 
 struct ScenarioOverride
+{
+    uint32_t filename = STRING_OFFSET_NONE;
+    uint32_t strings[ScenarioOverrideMaxStringCount] = { STRING_OFFSET_NONE, STRING_OFFSET_NONE, STRING_OFFSET_NONE };
+};
+assert_struct_size(ScenarioOverride, 16);
+#pragma pack(pop)
+
+struct ParsedObjectOverride
+{
+    char name[8] = { 0 };
+    std::string strings[ObjectOverrideMaxStringCount];
+};
+
+struct ParsedScenarioOverride
 {
     std::string filename;
     std::string strings[ScenarioOverrideMaxStringCount];
@@ -57,22 +98,36 @@ class LanguagePack final : public ILanguagePack
 {
 private:
     uint16_t const _id;
-    std::vector<std::string> _strings;
+
+    // Compiled form, the overrides and offsets point into the string data.
+    std::vector<uint32_t> _stringOffsets;
     std::vector<ObjectOverride> _objectOverrides;
     std::vector<ScenarioOverride> _scenarioOverrides;
+    std::vector<utf8> _stringData;
+
+    std::vector<const utf8*> _strings;
+    std::unordered_map<rct_string_id, std::string> _setStrings;
+    std::unordered_map<std::string, size_t> _objectOverrideIndex;
+    std::unordered_map<std::string, size_t> _scenarioOverrideIndex;
 
     ///////////////////////////////////////////////////////////////////////////
     // Parsing work data
     ///////////////////////////////////////////////////////////////////////////
     std::string _currentGroup;
-    ObjectOverride* _currentObjectOverride = nullptr;
-    ScenarioOverride* _currentScenarioOverride = nullptr;
+    std::vector<std::string> _parsedStrings;
+    std::vector<ParsedObjectOverride> _parsedObjectOverrides;
+    std::vector<ParsedScenarioOverride> _parsedScenarioOverrides;
+    ParsedObjectOverride* _currentObjectOverride = nullptr;
+    ParsedScenarioOverride* _currentScenarioOverride = nullptr;
 
 public:
-    static LanguagePack* FromFile(uint16_t id, const utf8* path)
+    static LanguagePack* FromFile(uint16_t id, const utf8* path, const utf8* compiledPath)
     {
         Guard::ArgumentNotNull(path);
 
+        CompiledLanguageHeader source;
+        source.LanguageId = id;
+
         // Load file directly into memory
         utf8* fileData = nullptr;
         try
@@ -96,10 +151,28 @@ public:
             return nullptr;
         }
 
+        // Skip parsing entirely if the compiled form is up to date
+        source.SourceSize = strlen(fileData);
+        source.SourceHash = GetSourceHash(fileData);
+        if (compiledPath != nullptr)
+        {
+            LanguagePack* compiled = FromCompiledFile(compiledPath, source);
+            if (compiled != nullptr)
+            {
+                Memory::Free(fileData);
+                return compiled;
+            }
+        }
+
         // Parse the memory as text
         LanguagePack* result = FromText(id, fileData);
 
         Memory::Free(fileData);
+
+        if (compiledPath != nullptr)
+        {
+            result->WriteCompiledFile(compiledPath, source);
+        }
         return result;
     }
 
@@ -119,10 +192,22 @@ public:
             ParseLine(&reader);
         }
 
+        Compile();
+
         // Clean up the parsing work data
         _currentGroup = std::string();
+        _parsedStrings = {};
+        _parsedObjectOverrides = {};
+        _parsedScenarioOverrides = {};
         _currentObjectOverride = nullptr;
         _currentScenarioOverride = nullptr;
+
+        BuildIndex();
+    }
+
+    explicit LanguagePack(uint16_t id)
+        : _id(id)
+    {
     }
 
     uint16_t GetId() const override
@@ -137,17 +222,20 @@ public:
 
     void RemoveString(rct_string_id stringId) override
     {
-        if (_strings.size() >= (size_t)stringId)
+        if (_strings.size() > (size_t)stringId)
         {
-            _strings[stringId] = std::string();
+            _strings[stringId] = nullptr;
+            _setStrings.erase(stringId);
         }
     }
 
     void SetString(rct_string_id stringId, const std::string& str) override
     {
-        if (_strings.size() >= (size_t)stringId)
+        if (_strings.size() > (size_t)stringId)
         {
-            _strings[stringId] = str;
+            auto& setString = _setStrings[stringId];
+            setString = str;
+            _strings[stringId] = setString.empty() ? nullptr : setString.c_str();
         }
     }
 
@@ -159,9 +247,9 @@ public:
             int32_t ooIndex = offset / ScenarioOverrideMaxStringCount;
             int32_t ooStringIndex = offset % ScenarioOverrideMaxStringCount;
 
-            if (_scenarioOverrides.size() > (size_t)ooIndex && !_scenarioOverrides[ooIndex].strings[ooStringIndex].empty())
+            if (_scenarioOverrides.size() > (size_t)ooIndex)
             {
-                return _scenarioOverrides[ooIndex].strings[ooStringIndex].c_str();
+                return GetCompiledString(_scenarioOverrides[ooIndex].strings[ooStringIndex]);
             }
             else
             {
@@ -174,9 +262,9 @@ public:
             int32_t ooIndex = offset / ObjectOverrideMaxStringCount;
             int32_t ooStringIndex = offset % ObjectOverrideMaxStringCount;
 
-            if (_objectOverrides.size() > (size_t)ooIndex && !_objectOverrides[ooIndex].strings[ooStringIndex].empty())
+            if (_objectOverrides.size() > (size_t)ooIndex)
             {
-                return _objectOverrides[ooIndex].strings[ooStringIndex].c_str();
+                return GetCompiledString(_objectOverrides[ooIndex].strings[ooStringIndex]);
             }
             else
             {
@@ -185,9 +273,9 @@ public:
         }
         else
         {
-            if ((_strings.size() > (size_t)stringId) && !_strings[stringId].empty())
+            if (_strings.size() > (size_t)stringId)
             {
-                return _strings[stringId].c_str();
+                return _strings[stringId];
             }
             else
             {
@@ -201,18 +289,15 @@ public:
         Guard::ArgumentNotNull(objectIdentifier);
         Guard::Assert(index < ObjectOverrideMaxStringCount);
 
-        int32_t ooIndex = 0;
-        for (const ObjectOverride& objectOverride : _objectOverrides)
+        auto it = _objectOverrideIndex.find(GetObjectOverrideKey(objectIdentifier));
+        if (it != _objectOverrideIndex.end())
         {
-            if (strncmp(objectOverride.name, objectIdentifier, 8) == 0)
+            size_t ooIndex = it->second;
+            if (_objectOverrides[ooIndex].strings[index] == STRING_OFFSET_NONE)
             {
-                if (objectOverride.strings[index].empty())
-                {
-                    return STR_NONE;
-                }
-                return ObjectOverrideBase + (ooIndex * ObjectOverrideMaxStringCount) + index;
+                return STR_NONE;
             }
-            ooIndex++;
+            return ObjectOverrideBase + (rct_string_id)(ooIndex * ObjectOverrideMaxStringCount) + index;
         }
 
         return STR_NONE;
@@ -223,27 +308,240 @@ public:
         Guard::ArgumentNotNull(scenarioFilename);
         Guard::Assert(index < ScenarioOverrideMaxStringCount);
 
-        int32_t ooIndex = 0;
-        for (const ScenarioOverride& scenarioOverride : _scenarioOverrides)
+        auto it = _scenarioOverrideIndex.find(GetScenarioOverrideKey(scenarioFilename));
+        if (it != _scenarioOverrideIndex.end())
         {
-            if (String::Equals(scenarioOverride.filename.c_str(), scenarioFilename, true))
+            size_t ooIndex = it->second;
+            if (_scenarioOverrides[ooIndex].strings[index] == STRING_OFFSET_NONE)
             {
-                if (scenarioOverride.strings[index].empty())
-                {
-                    return STR_NONE;
-                }
-                return ScenarioOverrideBase + (ooIndex * ScenarioOverrideMaxStringCount) + index;
+                return STR_NONE;
             }
-            ooIndex++;
+            return ScenarioOverrideBase + (rct_string_id)(ooIndex * ScenarioOverrideMaxStringCount) + index;
         }
 
         return STR_NONE;
     }
 
 private:
-    ObjectOverride* GetObjectOverride(const std::string& objectIdentifier)
+    static std::string GetObjectOverrideKey(const char* objectIdentifier)
+    {
+        return std::string(objectIdentifier, strnlen(objectIdentifier, 8));
+    }
+
+    static std::string GetScenarioOverrideKey(const utf8* scenarioFilename)
+    {
+        // Scenario file names are compared case insensitively.
+        std::string key = scenarioFilename;
+        std::transform(key.begin(), key.end(), key.begin(), [](char c) { return (char)toupper((unsigned char)c); });
+        return key;
+    }
+
+    const utf8* GetCompiledString(uint32_t offset) const
+    {
+        return offset == STRING_OFFSET_NONE ? nullptr : &_stringData[offset];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Compiled form
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Parsing the text files on every start is slow, so the parsed strings are packed into a single block of string data with
+    // offsets pointing into it. This block is written to the cache directory and read back as is the next time the same text
+    // file is loaded by the same build.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    static uint64_t GetSourceHash(const utf8* text)
+    {
+        // FNV-1a, hashing the text is far cheaper than parsing it.
+        uint64_t hash = 0xCBF29CE484222325;
+        for (const utf8* ch = text; *ch != '\0'; ch++)
+        {
+            hash = (hash ^ (uint8_t)*ch) * 0x100000001B3;
+        }
+        return hash;
+    }
+
+    static uint32_t GetBuildChecksum()
+    {
+        // String tokens are converted to codes while parsing, which may change between builds.
+        uint32_t checksum = 0;
+        for (const utf8* ch = gVersionInfoFull; *ch != '\0'; ch++)
+        {
+            checksum = ror32(checksum, 11) ^ (uint8_t)*ch;
+        }
+        return checksum;
+    }
+
+    uint32_t AddCompiledString(const std::string& str)
+    {
+        if (str.empty())
+        {
+            return STRING_OFFSET_NONE;
+        }
+
+        auto offset = (uint32_t)_stringData.size();
+        _stringData.insert(_stringData.end(), str.begin(), str.end());
+        _stringData.push_back('\0');
+        return offset;
+    }
+
+    void Compile()
+    {
+        _stringOffsets.reserve(_parsedStrings.size());
+        for (const auto& str : _parsedStrings)
+        {
+            _stringOffsets.push_back(AddCompiledString(str));
+        }
+
+        _objectOverrides.reserve(_parsedObjectOverrides.size());
+        for (const auto& parsed : _parsedObjectOverrides)
+        {
+            ObjectOverride objectOverride;
+            std::copy_n(parsed.name, 8, objectOverride.name);
+            for (int32_t i = 0; i < ObjectOverrideMaxStringCount; i++)
+            {
+                objectOverride.strings[i] = AddCompiledString(parsed.strings[i]);
+            }
+            _objectOverrides.push_back(objectOverride);
+        }
+
+        _scenarioOverrides.reserve(_parsedScenarioOverrides.size());
+        for (const auto& parsed : _parsedScenarioOverrides)
+        {
+            ScenarioOverride scenarioOverride;
+            scenarioOverride.filename = AddCompiledString(parsed.filename);
+            for (int32_t i = 0; i < ScenarioOverrideMaxStringCount; i++)
+            {
+                scenarioOverride.strings[i] = AddCompiledString(parsed.strings[i]);
+            }
+            _scenarioOverrides.push_back(scenarioOverride);
+        }
+    }
+
+    void BuildIndex()
+    {
+        _strings.resize(_stringOffsets.size());
+        for (size_t i = 0; i < _stringOffsets.size(); i++)
+        {
+            _strings[i] = GetCompiledString(_stringOffsets[i]);
+        }
+
+        _objectOverrideIndex.reserve(_objectOverrides.size());
+        for (size_t i = 0; i < _objectOverrides.size(); i++)
+        {
+            _objectOverrideIndex.emplace(GetObjectOverrideKey(_objectOverrides[i].name), i);
+        }
+
+        _scenarioOverrideIndex.reserve(_scenarioOverrides.size());
+        for (size_t i = 0; i < _scenarioOverrides.size(); i++)
+        {
+            const utf8* filename = GetCompiledString(_scenarioOverrides[i].filename);
+            if (filename != nullptr)
+            {
+                _scenarioOverrideIndex.emplace(GetScenarioOverrideKey(filename), i);
+            }
+        }
+    }
+
+    static LanguagePack* FromCompiledFile(const utf8* compiledPath, const CompiledLanguageHeader& source)
+    {
+        try
+        {
+            auto fs = FileStream(compiledPath, FILE_MODE_OPEN);
+            auto header = fs.ReadValue<CompiledLanguageHeader>();
+            if (header.MagicNumber != COMPILED_LANGUAGE_MAGIC || header.Version != COMPILED_LANGUAGE_VERSION
+                || header.LanguageId != source.LanguageId || header.SourceSize != source.SourceSize
+                || header.SourceHash != source.SourceHash || header.BuildChecksum != GetBuildChecksum())
+            {
+                log_verbose("Compiled language pack '%s' is out of date.", compiledPath);
+                return nullptr;
+            }
+
+            auto result = std::make_unique<LanguagePack>(source.LanguageId);
+            result->_stringOffsets.resize(header.NumStrings);
+            result->_objectOverrides.resize(header.NumObjectOverrides);
+            result->_scenarioOverrides.resize(header.NumScenarioOverrides);
+            result->_stringData.resize(header.StringDataSize);
+            fs.Read(result->_stringOffsets.data(), header.NumStrings * sizeof(uint32_t));
+            fs.Read(result->_objectOverrides.data(), header.NumObjectOverrides * sizeof(ObjectOverride));
+            fs.Read(result->_scenarioOverrides.data(), header.NumScenarioOverrides * sizeof(ScenarioOverride));
+            fs.Read(result->_stringData.data(), header.StringDataSize);
+
+            if (!result->IsCompiledDataValid())
+            {
+                log_warning("Compiled language pack '%s' is corrupt.", compiledPath);
+                return nullptr;
+            }
+
+            result->BuildIndex();
+            return result.release();
+        }
+        catch (const std::exception& ex)
+        {
+            // The compiled form does not exist until the language has been loaded once.
+            log_verbose("Unable to read compiled language pack '%s': %s", compiledPath, ex.what());
+            return nullptr;
+        }
+    }
+
+    bool IsCompiledDataValid() const
+    {
+        if (!_stringData.empty() && _stringData.back() != '\0')
+        {
+            return false;
+        }
+
+        auto isValid = [this](uint32_t offset) { return offset == STRING_OFFSET_NONE || offset < _stringData.size(); };
+        if (!std::all_of(_stringOffsets.begin(), _stringOffsets.end(), isValid))
+        {
+            return false;
+        }
+        for (const auto& objectOverride : _objectOverrides)
+        {
+            if (!std::all_of(std::begin(objectOverride.strings), std::end(objectOverride.strings), isValid))
+            {
+                return false;
+            }
+        }
+        for (const auto& scenarioOverride : _scenarioOverrides)
+        {
+            if (!isValid(scenarioOverride.filename)
+                || !std::all_of(std::begin(scenarioOverride.strings), std::end(scenarioOverride.strings), isValid))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void WriteCompiledFile(const utf8* compiledPath, const CompiledLanguageHeader& source) const
+    {
+        try
+        {
+            log_verbose("Writing compiled language pack '%s'", compiledPath);
+            auto fs = FileStream(compiledPath, FILE_MODE_WRITE);
+
+            CompiledLanguageHeader header = source;
+            header.BuildChecksum = GetBuildChecksum();
+            header.NumStrings = (uint32_t)_stringOffsets.size();
+            header.NumObjectOverrides = (uint32_t)_objectOverrides.size();
+            header.NumScenarioOverrides = (uint32_t)_scenarioOverrides.size();
+            header.StringDataSize = (uint32_t)_stringData.size();
+            fs.WriteValue(header);
+
+            fs.Write(_stringOffsets.data(), _stringOffsets.size() * sizeof(uint32_t));
+            fs.Write(_objectOverrides.data(), _objectOverrides.size() * sizeof(ObjectOverride));
+            fs.Write(_scenarioOverrides.data(), _scenarioOverrides.size() * sizeof(ScenarioOverride));
+            fs.Write(_stringData.data(), _stringData.size());
+        }
+        catch (const std::exception& ex)
+        {
+            log_warning("Unable to write compiled language pack '%s': %s", compiledPath, ex.what());
+        }
+    }
+
+    ParsedObjectOverride* GetObjectOverride(const std::string& objectIdentifier)
     {
-        for (auto& oo : _objectOverrides)
+        for (auto& oo : _parsedObjectOverrides)
         {
             if (strncmp(oo.name, objectIdentifier.c_str(), 8) == 0)
             {
@@ -253,9 +551,9 @@ private:
         return nullptr;
     }
 
-    ScenarioOverride* GetScenarioOverride(const std::string& scenarioIdentifier)
+    ParsedScenarioOverride* GetScenarioOverride(const std::string& scenarioIdentifier)
     {
-        for (auto& so : _scenarioOverrides)
+        for (auto& so : _parsedScenarioOverrides)
         {
             if (String::Equals(so.strings[0], scenarioIdentifier.c_str(), true))
             {
@@ -405,13 +703,13 @@ private:
                 _currentScenarioOverride = nullptr;
                 if (_currentObjectOverride == nullptr)
                 {
-                    if (_objectOverrides.size() == MAX_OBJECT_OVERRIDES)
+                    if (_parsedObjectOverrides.size() == MAX_OBJECT_OVERRIDES)
                     {
                         log_warning("Maximum number of localised object strings exceeded.");
                     }
 
-                    _objectOverrides.push_back(ObjectOverride());
-                    _currentObjectOverride = &_objectOverrides[_objectOverrides.size() - 1];
+                    _parsedObjectOverrides.push_back(ParsedObjectOverride());
+                    _currentObjectOverride = &_parsedObjectOverrides[_parsedObjectOverrides.size() - 1];
                     std::copy_n(_currentGroup.c_str(), 8, _currentObjectOverride->name);
                 }
             }
@@ -449,13 +747,13 @@ private:
             _currentScenarioOverride = GetScenarioOverride(_currentGroup);
             if (_currentScenarioOverride == nullptr)
             {
-                if (_scenarioOverrides.size() == MAX_SCENARIO_OVERRIDES)
+                if (_parsedScenarioOverrides.size() == MAX_SCENARIO_OVERRIDES)
                 {
                     log_warning("Maximum number of scenario strings exceeded.");
                 }
 
-                _scenarioOverrides.push_back(ScenarioOverride());
-                _currentScenarioOverride = &_scenarioOverrides[_scenarioOverrides.size() - 1];
+                _parsedScenarioOverrides.push_back(ParsedScenarioOverride());
+                _currentScenarioOverride = &_parsedScenarioOverrides[_parsedScenarioOverrides.size() - 1];
                 _currentScenarioOverride->filename = std::string(sb.GetBuffer());
             }
         }
@@ -587,11 +885,11 @@ private:
         if (_currentGroup.empty())
         {
             // Make sure the list is big enough to contain this string id
-            if ((size_t)stringId >= _strings.size())
+            if ((size_t)stringId >= _parsedStrings.size())
             {
-                _strings.resize(stringId + 1);
+                _parsedStrings.resize(stringId + 1);
             }
-            _strings[stringId] = s;
+            _parsedStrings[stringId] = s;
         }
         else
         {
@@ -681,9 +979,9 @@ private:
 
 namespace LanguagePackFactory
 {
-    ILanguagePack* FromFile(uint16_t id, const utf8* path)
+    ILanguagePack* FromFile(uint16_t id, const utf8* path, const utf8* compiledPath)
     {
-        auto languagePack = LanguagePack::FromFile(id, path);
+        auto languagePack = LanguagePack::FromFile(id, path, compiledPath);
         return languagePack;
     }
 
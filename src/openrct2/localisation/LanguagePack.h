@@ -29,6 +29,10 @@ interface ILanguagePack
 
 namespace LanguagePackFactory
 {
-    ILanguagePack* FromFile(uint16_t id, const utf8* path);
+    /**
+     * Loads the language file at the given path. If a compiled path is given, the compiled form stored there is
+     * used instead of parsing the text if it is up to date, otherwise it is written there after parsing.
+     */
+    ILanguagePack* FromFile(uint16_t id, const utf8* path, const utf8* compiledPath = nullptr);
     ILanguagePack* FromText(uint16_t id, const utf8* text);
 } // namespace LanguagePackFactory
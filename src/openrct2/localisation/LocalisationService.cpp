@@ -74,6 +74,14 @@ std::string LocalisationService::GetLanguagePath(uint32_t languageId) const
     return languagePath;
 }
 
+std::string LocalisationService::GetCompiledLanguagePath(uint32_t languageId) const
+{
+    auto locale = std::string(LanguagesDescriptors[languageId].locale);
+    auto cacheDirectory = _env->GetDirectoryPath(DIRBASE::CACHE);
+    auto compiledPath = Path::Combine(cacheDirectory, "language_" + locale + ".dat");
+    return compiledPath;
+}
+
 void LocalisationService::OpenLanguage(int32_t id, IObjectManager& objectManager)
 {
     CloseLanguages();
@@ -82,16 +90,23 @@ void LocalisationService::OpenLanguage(int32_t id, IObjectManager& objectManager
         throw std::invalid_argument("id was undefined");
     }
 
+    // Compiled language packs are written to the cache directory
+    Path::CreateDirectory(_env->GetDirectoryPath(DIRBASE::CACHE));
+
     std::string filename;
+    std::string compiledFilename;
     if (id != LANGUAGE_ENGLISH_UK)
     {
         filename = GetLanguagePath(LANGUAGE_ENGLISH_UK);
+        compiledFilename = GetCompiledLanguagePath(LANGUAGE_ENGLISH_UK);
         _languageFallback = std::unique_ptr<ILanguagePack>(
-            LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str()));
+            LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str(), compiledFilename.c_str()));
     }
 
     filename = GetLanguagePath(id);
-    _languageCurrent = std::unique_ptr<ILanguagePack>(LanguagePackFactory::FromFile(id, filename.c_str()));
+    compiledFilename = GetCompiledLanguagePath(id);
+    _languageCurrent = std::unique_ptr<ILanguagePack>(
+        LanguagePackFactory::FromFile(id, filename.c_str(), compiledFilename.c_str()));
     if (_languageCurrent != nullptr)
     {
         _currentLanguage = id;
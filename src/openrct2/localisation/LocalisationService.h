@@ -58,6 +58,7 @@ namespace OpenRCT2::Localisation
             const std::string& scenarioFilename) const;
         rct_string_id GetObjectOverrideStringId(const char* identifier, uint8_t index) const;
         std::string GetLanguagePath(uint32_t languageId) const;
+        std::string GetCompiledLanguagePath(uint32_t languageId) const;
 
         void OpenLanguage(int32_t id, IObjectManager& objectManager);
         void CloseLanguages();
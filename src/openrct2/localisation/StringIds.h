@@ -3965,6 +3965,8 @@ enum
     STR_TRANSPARENT_SCREENSHOT = 6327,
     STR_TRANSPARENT_SCREENSHOT_TIP = 6328,
 
+    STR_MULTIPLAYER_CATCHING_UP = 6329,
+
     // Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
     STR_COUNT = 32768
 };
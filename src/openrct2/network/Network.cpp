@@ -33,7 +33,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "38"
+#define NETWORK_STREAM_VERSION "41"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -71,24 +71,31 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "NetworkAction.h"
 #    include "NetworkConnection.h"
 #    include "NetworkGroup.h"
+#    include "NetworkIoThread.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkPlayer.h"
+#    include "NetworkRelayQueue.h"
+#    include "NetworkResyncHistory.h"
 #    include "NetworkServerAdvertiser.h"
+#    include "NetworkTickBatch.h"
 #    include "NetworkUser.h"
 #    include "Socket.h"
 
 #    include <algorithm>
 #    include <array>
 #    include <cerrno>
+#    include <chrono>
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
+#    include <future>
 #    include <list>
 #    include <map>
 #    include <memory>
 #    include <set>
 #    include <string>
+#    include <tuple>
 #    include <vector>
 
 #    pragma comment(lib, "Ws2_32.lib")
@@ -101,10 +108,11 @@ enum
     SERVER_EVENT_PLAYER_DISCONNECTED,
 };
 
-enum
-{
-    NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
-};
+// Clients that lost the connection can continue from their own game state for about a minute.
+constexpr uint32_t NETWORK_RESYNC_HISTORY_TICKS = 60 * 1000 / GAME_UPDATE_TIME_MS;
+constexpr size_t NETWORK_RESYNC_HISTORY_MAX_SIZE = 16 * 1024 * 1024;
+// Clients joining within a few seconds of each other receive the same map and catch up from the game stream.
+constexpr uint32_t NETWORK_MAP_PAYLOAD_TICKS = 5 * 1000 / GAME_UPDATE_TIME_MS;
 
 static void network_chat_show_connected_message();
 static void network_chat_show_server_greeting();
@@ -123,6 +131,7 @@ public:
     void Close();
     bool BeginClient(const std::string& host, uint16_t port);
     bool BeginServer(uint16_t port, const std::string& address);
+    bool BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& address);
     int32_t GetMode();
     int32_t GetStatus();
     int32_t GetAuthStatus();
@@ -142,6 +151,8 @@ public:
     NetworkGroup* GetGroupByID(uint8_t id);
     static const char* FormatChat(NetworkPlayer* fromplayer, const char* text);
     void SendPacketToClients(NetworkPacket& packet, bool front = false, bool gameCmd = false);
+    void SendPacketToClients(const NetworkPacketPayloadPtr& payload, bool front = false, bool gameCmd = false);
+    void SendGameStreamPacket(NetworkPacket& packet, uint32_t tick, bool gameCmd = false);
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool IsDesynchronised();
     bool CheckDesynchronizaton();
@@ -176,7 +187,7 @@ public:
         const std::string& name, const std::string& password, const std::string& pubkey, const std::vector<uint8_t>& signature);
     void Server_Send_AUTH(NetworkConnection& connection);
     void Server_Send_TOKEN(NetworkConnection& connection);
-    void Server_Send_MAP(NetworkConnection* connection = nullptr);
+    void Server_Send_MAP(NetworkConnection* connection = nullptr, const std::vector<const ObjectRepositoryItem*>& objects = {});
     void Client_Send_CHAT(const char* text);
     void Server_Send_CHAT(const char* text);
     void Client_Send_GAMECMD(
@@ -187,6 +198,7 @@ public:
     void Client_Send_GAME_ACTION(const GameAction* action);
     void Server_Send_GAME_ACTION(const GameAction* action);
     void Server_Send_TICK();
+    void Server_Send_TICK_BATCH();
     void Server_Send_PLAYERINFO(int32_t playerId);
     void Server_Send_PLAYERLIST();
     void Client_Send_PING();
@@ -200,9 +212,16 @@ public:
     void Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName, const char* reason);
     void Client_Send_GAMEINFO();
     void Client_Send_OBJECTS(const std::vector<std::string>& objects);
+    void Client_Send_RESYNC(const std::vector<std::string>& objects);
+    bool Server_Send_RESYNC(
+        NetworkConnection& connection, uint32_t tick, uint32_t commands, uint32_t confirmedTick,
+        const std::string& confirmedHash);
     void Server_Send_OBJECTS(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
 
     NetworkStats_t GetStats() const;
+    std::vector<std::pair<std::string, NetworkStats_t>> GetConnectionStats() const;
+    json_t* GetStatsAsJson() const;
+    std::string DumpStats() const;
     json_t* GetServerInfoAsJson() const;
 
     std::vector<std::unique_ptr<NetworkPlayer>> player_list;
@@ -223,8 +242,12 @@ private:
     void CloseConnection();
 
     bool ProcessConnection(NetworkConnection& connection);
+    bool CheckConnectionTimeout(NetworkConnection& connection);
+    void ProcessClientConnections();
+    void ServeClientConnections();
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
-    void AddClient(std::unique_ptr<ITcpSocket>&& socket);
+    void ProcessIoEvents();
+    void AddClient(std::unique_ptr<NetworkConnection>&& connection);
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
 
     void RemovePlayer(std::unique_ptr<NetworkConnection>& connection);
@@ -236,7 +259,7 @@ private:
     void SetupDefaultGroups();
 
     bool LoadMap(IStream* stream);
-    bool SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::function<std::vector<uint8_t>()> SaveMap(const std::vector<const ObjectRepositoryItem*>& objects) const;
 
     struct GameCommand
     {
@@ -298,7 +321,31 @@ private:
         std::string spriteHash;
     };
 
+    // Packed and compressed custom object, ready to be queued on any connection.
+    using ObjectPayload = std::shared_future<std::vector<NetworkPacketPayloadPtr>>;
+
+    // A joining client waiting for its map and the objects it has to receive before it.
+    struct MapReceiver
+    {
+        NetworkConnection* Connection = nullptr;
+        std::vector<ObjectPayload> Objects;
+    };
+
+    // Compressed map shared by all connections that join shortly after it was captured.
+    struct MapPayload
+    {
+        uint32_t Tick = 0;
+        // Sequence number of the first packet of the game stream sent after the map was captured.
+        uint64_t Sequence = 0;
+        std::future<std::vector<uint8_t>> Pending;
+        std::vector<NetworkPacketPayloadPtr> Packets;
+        std::vector<MapReceiver> Receivers;
+    };
+
     std::map<uint32_t, ServerTickData_t> _serverTickData;
+    // The tick currently being run by the server, sent with all its game actions once the tick is flushed.
+    NetworkTickBatch _tickBatch;
+    bool _tickBatchPending = false;
     std::map<uint32_t, PlayerListUpdate> _pendingPlayerLists;
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     bool _playerListInvalidated = false;
@@ -310,6 +357,7 @@ private:
     bool wsa_initialized = false;
     bool _clientMapLoaded = false;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    std::unique_ptr<NetworkIoThread> _ioThread;
     std::unique_ptr<NetworkConnection> _serverConnection;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     uint16_t listening_port = 0;
@@ -317,10 +365,37 @@ private:
     uint32_t last_ping_sent_time = 0;
     uint8_t player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    // Removed connections the I/O thread may still be using.
+    std::list<std::unique_ptr<NetworkConnection>> _releasingConnections;
     std::multiset<GameCommand> game_command_queue;
+    std::list<MapPayload> _mapPayloads;
+    // Objects only change when the server is restarted, so they are packed once for every client that lacks them.
+    std::map<std::pair<std::string, uint32_t>, ObjectPayload> _objectPayloads;
+    std::list<std::future<void>> _objectPackers;
     std::vector<uint8_t> chunk_buffer;
+    std::vector<uint8_t> _objectData;
+    NetworkRelayQueue _relayPackets;
+    // The game stream of the last ticks, replayed to clients that reconnect with a game state they confirmed before.
+    NetworkResyncHistory _resyncHistory{ NETWORK_RESYNC_HISTORY_TICKS, NETWORK_RESYNC_HISTORY_MAX_SIZE };
+    // The game state of the client when it lost the connection, restored instead of receiving the map again.
+    std::shared_future<std::vector<uint8_t>> _resyncMap;
+    uint32_t _resyncTick = 0;
+    uint32_t _resyncCommands = 0;
+    uint32_t _resyncConfirmedTick = 0;
+    std::string _resyncConfirmedHash;
+    // The last state hash of the server the client has matched.
+    uint32_t _confirmedTick = 0;
+    std::string _confirmedHash;
+    // The tick whose game commands the client has processed last.
+    uint32_t _processedTick = 0;
+    // The game commands of the current tick that are part of the game state, while paused these run before the tick.
+    uint32_t _processedCommands = 0;
+    bool _processedCommandsKnown = false;
     std::string _host;
     uint16_t _port = 0;
+    // Port the relay listens on for spectators, 0 when not relaying.
+    uint16_t _relayPort = 0;
+    std::string _relayAddress;
     std::string _password;
     NetworkServerState_t _serverState;
     MemoryStream _serverGameState;
@@ -330,6 +405,7 @@ private:
     uint32_t _actionId;
     uint32_t _lastUpdateTime = 0;
     uint32_t _currentDeltaTime = 0;
+    uint32_t _lastStatsDumpTime = 0;
     std::string _chatLogPath;
     std::string _chatLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::string _serverLogPath;
@@ -338,15 +414,34 @@ private:
 
     void UpdateServer();
     void UpdateClient();
+    void UpdateRelay();
+    void UpdateMapPayloads();
+    bool SendMapPayload(const MapPayload& payload, const MapReceiver& receiver);
+    bool IsMapPayloadCurrent(const MapPayload& payload) const;
+    void ClearMapPayloads();
+    bool GetObjectPayloads(const std::vector<const ObjectRepositoryItem*>& objects, std::vector<ObjectPayload>& payloads);
+    static std::vector<NetworkPacketPayloadPtr> CreateMapPackets(const std::vector<uint8_t>& data);
+    static std::vector<NetworkPacketPayloadPtr> CreateObjectPackets(const std::string& name, const MemoryStream& data);
+    bool ReadObjectRequest(
+        NetworkConnection& connection, NetworkPacket& packet, std::vector<const ObjectRepositoryItem*>& objects);
+    void Relay_QueuePacket(const NetworkPacket& packet);
+    void Relay_SendPackets();
+    void Relay_RestartSpectators();
+    void ResetResyncHistory();
+    void Client_SaveResyncPoint();
+    void Client_MapLoaded(bool resumed);
+    static std::vector<uint8_t> DecompressMap(const uint8_t* data, size_t size);
 
 private:
     std::vector<void (Network::*)(NetworkConnection& connection, NetworkPacket& packet)> client_command_handlers;
     std::vector<void (Network::*)(NetworkConnection& connection, NetworkPacket& packet)> server_command_handlers;
+    std::vector<void (Network::*)(NetworkConnection& connection, NetworkPacket& packet)> relay_command_handlers;
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Client_Joined(const char* name, const std::string& keyhash, NetworkConnection& connection);
     void Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_OBJECT_DATA(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMECMD(NetworkConnection& connection, NetworkPacket& packet);
@@ -354,6 +449,9 @@ private:
     void Client_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_TICK_BATCH(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_ReceiveTick(uint32_t serverTick, uint32_t srand0, const std::string& spriteHash);
+    void Client_QueueGameAction(uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size);
     void Client_Handle_PLAYERINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERLIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PING(NetworkConnection& connection, NetworkPacket& packet);
@@ -370,8 +468,12 @@ private:
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
-
-    uint8_t* save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    void Client_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_GAMEINFO(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
 
     std::ofstream _chat_log_fs;
     std::ofstream _server_log_fs;
@@ -390,10 +492,12 @@ Network::Network()
     client_command_handlers.resize(NETWORK_COMMAND_MAX, nullptr);
     client_command_handlers[NETWORK_COMMAND_AUTH] = &Network::Client_Handle_AUTH;
     client_command_handlers[NETWORK_COMMAND_MAP] = &Network::Client_Handle_MAP;
+    client_command_handlers[NETWORK_COMMAND_OBJECT_DATA] = &Network::Client_Handle_OBJECT_DATA;
     client_command_handlers[NETWORK_COMMAND_CHAT] = &Network::Client_Handle_CHAT;
     client_command_handlers[NETWORK_COMMAND_GAMECMD] = &Network::Client_Handle_GAMECMD;
     client_command_handlers[NETWORK_COMMAND_GAME_ACTION] = &Network::Client_Handle_GAME_ACTION;
     client_command_handlers[NETWORK_COMMAND_TICK] = &Network::Client_Handle_TICK;
+    client_command_handlers[NETWORK_COMMAND_TICK_BATCH] = &Network::Client_Handle_TICK_BATCH;
     client_command_handlers[NETWORK_COMMAND_PLAYERLIST] = &Network::Client_Handle_PLAYERLIST;
     client_command_handlers[NETWORK_COMMAND_PLAYERINFO] = &Network::Client_Handle_PLAYERINFO;
     client_command_handlers[NETWORK_COMMAND_PING] = &Network::Client_Handle_PING;
@@ -406,6 +510,7 @@ Network::Network()
     client_command_handlers[NETWORK_COMMAND_TOKEN] = &Network::Client_Handle_TOKEN;
     client_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Client_Handle_OBJECTS;
     client_command_handlers[NETWORK_COMMAND_GAMESTATE] = &Network::Client_Handle_GAMESTATE;
+    client_command_handlers[NETWORK_COMMAND_RESYNC] = &Network::Client_Handle_RESYNC;
     server_command_handlers.resize(NETWORK_COMMAND_MAX, nullptr);
     server_command_handlers[NETWORK_COMMAND_AUTH] = &Network::Server_Handle_AUTH;
     server_command_handlers[NETWORK_COMMAND_CHAT] = &Network::Server_Handle_CHAT;
@@ -416,6 +521,14 @@ Network::Network()
     server_command_handlers[NETWORK_COMMAND_TOKEN] = &Network::Server_Handle_TOKEN;
     server_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Server_Handle_OBJECTS;
     server_command_handlers[NETWORK_COMMAND_REQUEST_GAMESTATE] = &Network::Server_Handle_REQUEST_GAMESTATE;
+    server_command_handlers[NETWORK_COMMAND_RESYNC] = &Network::Server_Handle_RESYNC;
+    relay_command_handlers.resize(NETWORK_COMMAND_MAX, nullptr);
+    relay_command_handlers[NETWORK_COMMAND_AUTH] = &Network::Relay_Handle_AUTH;
+    relay_command_handlers[NETWORK_COMMAND_PING] = &Network::Server_Handle_PING;
+    relay_command_handlers[NETWORK_COMMAND_GAMEINFO] = &Network::Relay_Handle_GAMEINFO;
+    relay_command_handlers[NETWORK_COMMAND_TOKEN] = &Network::Server_Handle_TOKEN;
+    relay_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Relay_Handle_OBJECTS;
+    relay_command_handlers[NETWORK_COMMAND_RESYNC] = &Network::Relay_Handle_RESYNC;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -455,7 +568,14 @@ void Network::Reconnect()
         _requireReconnect = true;
         return;
     }
-    BeginClient(_host, _port);
+    if (_relayPort != 0)
+    {
+        BeginRelay(_host, _port, _relayPort, _relayAddress);
+    }
+    else
+    {
+        BeginClient(_host, _port);
+    }
 }
 
 void Network::Close()
@@ -475,8 +595,15 @@ void Network::Close()
         CloseServerLog();
         CloseConnection();
 
+        _mapPayloads.clear();
+        _objectPackers.clear();
+        _objectPayloads.clear();
+        _relayPackets.Clear();
+        ResetResyncHistory();
         client_connection_list.clear();
+        _releasingConnections.clear();
         game_command_queue.clear();
+        _tickBatchPending = false;
         player_list.clear();
         group_list.clear();
         _serverTickData.clear();
@@ -509,9 +636,13 @@ void Network::CloseConnection()
     if (mode == NETWORK_MODE_CLIENT)
     {
         _serverConnection.reset();
+        // Only set when relaying to spectators.
+        _ioThread.reset();
+        _listenSocket.reset();
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _ioThread.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -537,8 +668,14 @@ bool Network::BeginClient(const std::string& host, uint16_t port)
     mode = NETWORK_MODE_CLIENT;
 
     log_info("Connecting to %s:%u", host.c_str(), port);
+    if (host != _host || port != _port)
+    {
+        // The game state can only be continued on the server it was saved from.
+        _resyncMap = {};
+    }
     _host = host;
     _port = port;
+    _relayPort = 0;
 
     _serverConnection = std::make_unique<NetworkConnection>();
     _serverConnection->Socket = CreateTcpSocket();
@@ -628,6 +765,8 @@ bool Network::BeginServer(uint16_t port, const std::string& address)
         return false;
 
     mode = NETWORK_MODE_SERVER;
+    _resyncMap = {};
+    ResetResyncHistory();
 
     _userManager.Load();
 
@@ -645,6 +784,13 @@ bool Network::BeginServer(uint16_t port, const std::string& address)
         return false;
     }
 
+    // Serve the clients from a separate thread where supported, otherwise they are polled every frame.
+    _ioThread = NetworkIoThread::Create(*_listenSocket);
+    if (_ioThread != nullptr)
+    {
+        log_verbose("Using network I/O thread");
+    }
+
     ServerName = gConfigNetwork.server_name;
     ServerDescription = gConfigNetwork.server_description;
     ServerGreeting = gConfigNetwork.server_greeting;
@@ -689,6 +835,35 @@ bool Network::BeginServer(uint16_t port, const std::string& address)
     return true;
 }
 
+bool Network::BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& address)
+{
+    if (!BeginClient(host, port))
+    {
+        return false;
+    }
+
+    log_verbose("Begin listening for spectators");
+
+    _listenSocket = CreateTcpSocket();
+    try
+    {
+        _listenSocket->Listen(address, listenPort);
+    }
+    catch (const std::exception& ex)
+    {
+        Console::Error::WriteLine(ex.what());
+        Close();
+        return false;
+    }
+
+    _ioThread = NetworkIoThread::Create(*_listenSocket);
+    _relayPort = listenPort;
+    _relayAddress = address;
+
+    Console::WriteLine("Relaying %s:%u to spectators on port %u", host.c_str(), port, listenPort);
+    return true;
+}
+
 int32_t Network::GetMode()
 {
     return mode;
@@ -757,7 +932,26 @@ void Network::Flush()
 {
     if (GetMode() == NETWORK_MODE_CLIENT)
     {
+        _serverConnection->RecordSendQueueDepth();
         _serverConnection->SendQueuedPackets();
+        if (_relayPort == 0)
+        {
+            return;
+        }
+    }
+    else if (_tickBatchPending)
+    {
+        Server_Send_TICK_BATCH();
+    }
+
+    for (auto& it : client_connection_list)
+    {
+        it->RecordSendQueueDepth();
+    }
+
+    if (_ioThread != nullptr)
+    {
+        _ioThread->Flush();
     }
     else
     {
@@ -770,13 +964,61 @@ void Network::Flush()
 
 void Network::UpdateServer()
 {
+    ProcessClientConnections();
+
+    uint32_t ticks = platform_get_ticks();
+    if (ticks > last_ping_sent_time + 3000)
+    {
+        Server_Send_PING();
+        Server_Send_PINGLIST();
+    }
+
+    if (_advertiser != nullptr)
+    {
+        _advertiser->Update();
+    }
+
+    uint32_t statsDumpInterval = (uint32_t)std::max(gConfigNetwork.stats_dump_interval, 0) * 1000;
+    if (statsDumpInterval > 0 && ticks - _lastStatsDumpTime >= statsDumpInterval)
+    {
+        _lastStatsDumpTime = ticks;
+        DumpStats();
+    }
+
+    UpdateMapPayloads();
+    ServeClientConnections();
+}
+
+void Network::UpdateRelay()
+{
+    ProcessClientConnections();
+
+    uint32_t ticks = platform_get_ticks();
+    if (ticks > last_ping_sent_time + 3000)
+    {
+        Server_Send_PING();
+    }
+
+    UpdateMapPayloads();
+    ServeClientConnections();
+}
+
+void Network::ProcessClientConnections()
+{
+    if (_ioThread != nullptr)
+    {
+        ProcessIoEvents();
+    }
+
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
         if (connection->IsDisconnected)
             continue;
 
-        if (!ProcessConnection(*connection))
+        // Packets of connections served by the I/O thread have already been processed.
+        bool isConnected = connection->UsesIoThread ? CheckConnectionTimeout(*connection) : ProcessConnection(*connection);
+        if (!isConnected)
         {
             connection->IsDisconnected = true;
         }
@@ -785,23 +1027,24 @@ void Network::UpdateServer()
             DecayCooldown(connection->Player);
         }
     }
+}
 
-    uint32_t ticks = platform_get_ticks();
-    if (ticks > last_ping_sent_time + 3000)
-    {
-        Server_Send_PING();
-        Server_Send_PINGLIST();
-    }
-
-    if (_advertiser != nullptr)
+void Network::ServeClientConnections()
+{
+    if (_ioThread != nullptr)
     {
-        _advertiser->Update();
+        // Send the responses to the packets processed above.
+        _ioThread->Flush();
     }
-
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    else
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            auto connection = std::make_unique<NetworkConnection>();
+            connection->Socket = std::move(tcpSocket);
+            AddClient(std::move(connection));
+        }
     }
 }
 
@@ -905,11 +1148,17 @@ void Network::UpdateClient()
                     context_open_intent(&intent);
                 }
                 window_close_by_class(WC_MULTIPLAYER);
+                Client_SaveResyncPoint();
                 Close();
             }
             break;
         }
     }
+
+    if (_relayPort != 0 && !_requireClose)
+    {
+        UpdateRelay();
+    }
 }
 
 std::vector<std::unique_ptr<NetworkPlayer>>::iterator Network::GetPlayerIteratorByID(uint8_t id)
@@ -977,6 +1226,12 @@ const char* Network::FormatChat(NetworkPlayer* fromplayer, const char* text)
 }
 
 void Network::SendPacketToClients(NetworkPacket& packet, bool front, bool gameCmd)
+{
+    // Serialise the packet once, every connection queues the same payload.
+    SendPacketToClients(std::make_shared<const NetworkPacketPayload>(packet), front, gameCmd);
+}
+
+void Network::SendPacketToClients(const NetworkPacketPayloadPtr& payload, bool front, bool gameCmd)
 {
     for (auto& client_connection : client_connection_list)
     {
@@ -997,10 +1252,23 @@ void Network::SendPacketToClients(NetworkPacket& packet, bool front, bool gameCm
                 continue;
             }
         }
-        client_connection->QueuePacket(NetworkPacket::Duplicate(packet), front);
+        client_connection->QueuePacket(payload, front);
     }
 }
 
+void Network::SendGameStreamPacket(NetworkPacket& packet, uint32_t tick, bool gameCmd)
+{
+    auto payload = std::make_shared<const NetworkPacketPayload>(packet);
+    SendPacketToClients(payload, false, gameCmd);
+
+    _resyncHistory.Push(tick, payload);
+}
+
+void Network::ResetResyncHistory()
+{
+    _resyncHistory.Reset(gCurrentTicks);
+}
+
 bool Network::CheckSRAND(uint32_t tick, uint32_t srand0)
 {
     // We have to wait for the map to be loaded first, ticks may match current loaded map.
@@ -1029,6 +1297,8 @@ bool Network::CheckSRAND(uint32_t tick, uint32_t srand0)
             log_info("Sprite hash mismatch, client = %s, server = %s", clientSpriteHash.c_str(), storedTick.spriteHash.c_str());
             return false;
         }
+        _confirmedTick = tick;
+        _confirmedHash = clientSpriteHash;
     }
 
     return true;
@@ -1495,6 +1765,44 @@ void Network::Client_Send_OBJECTS(const std::vector<std::string>& objects)
     _serverConnection->QueuePacket(std::move(packet));
 }
 
+void Network::Client_Send_RESYNC(const std::vector<std::string>& objects)
+{
+    log_verbose(
+        "client resumes at tick %u after %u game commands, confirmed tick %u", _resyncTick, _resyncCommands,
+        _resyncConfirmedTick);
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << (uint32_t)NETWORK_COMMAND_RESYNC << _resyncTick << _resyncCommands << _resyncConfirmedTick;
+    packet->WriteString(_resyncConfirmedHash.c_str());
+    *packet << (uint32_t)objects.size();
+    for (const auto& object : objects)
+    {
+        packet->Write((const uint8_t*)object.c_str(), 8);
+    }
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
+bool Network::Server_Send_RESYNC(
+    NetworkConnection& connection, uint32_t tick, uint32_t commands, uint32_t confirmedTick, const std::string& confirmedHash)
+{
+    // The client must have matched the server after its last checksum and every packet since must still be known.
+    std::vector<NetworkPacketPayloadPtr> packets;
+    if (!_resyncHistory.IsConfirmed(confirmedTick, confirmedHash) || confirmedTick > tick || tick > gCurrentTicks
+        || !_resyncHistory.GetPacketsFrom(tick, commands, packets))
+    {
+        log_verbose("Client can not resume at tick %u, sending the map", tick);
+        return false;
+    }
+
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << (uint32_t)NETWORK_COMMAND_RESYNC << tick;
+    connection.QueuePacket(std::move(packet));
+    for (const auto& payload : packets)
+    {
+        connection.QueuePacket(payload);
+    }
+    return true;
+}
+
 void Network::Server_Send_TOKEN(NetworkConnection& connection)
 {
     std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
@@ -1522,17 +1830,13 @@ NetworkStats_t Network::GetStats() const
     NetworkStats_t stats = {};
     if (mode == NETWORK_MODE_CLIENT)
     {
-        stats = _serverConnection->Stats;
+        stats = _serverConnection->GetStats();
     }
     else
     {
         for (auto& connection : client_connection_list)
         {
-            for (size_t n = 0; n < NETWORK_STATISTICS_GROUP_MAX; n++)
-            {
-                stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
-                stats.bytesSent[n] += connection->Stats.bytesSent[n];
-            }
+            stats.Add(connection->GetStats());
         }
     }
     return stats;
@@ -1545,6 +1849,11 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
     {
         new_playerid = connection.Player->Id;
     }
+    else if (GetMode() == NETWORK_MODE_CLIENT)
+    {
+        // Spectators of a relay see the game through the player of the relay.
+        new_playerid = player_id;
+    }
     std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
     *packet << (uint32_t)NETWORK_COMMAND_AUTH << (uint32_t)connection.AuthStatus << new_playerid;
     if (connection.AuthStatus == NETWORK_AUTH_BADVERSION)
@@ -1558,103 +1867,321 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
     }
 }
 
-void Network::Server_Send_MAP(NetworkConnection* connection)
+void Network::Server_Send_MAP(NetworkConnection* connection, const std::vector<const ObjectRepositoryItem*>& objects)
 {
-    std::vector<const ObjectRepositoryItem*> objects;
-    if (connection)
-    {
-        objects = connection->RequestedObjects;
-    }
-    else
+    if (connection == nullptr)
     {
         // This will send all custom objects to connected clients
         // TODO: fix it so custom objects negotiation is performed even in this case.
         auto context = GetContext();
         auto& objManager = context->GetObjectManager();
-        objects = objManager.GetPackableObjects();
+
+        // Everyone receives the new map, no point in deferring it.
+        ClearMapPayloads();
+        auto compressMap = SaveMap(objManager.GetPackableObjects());
+        auto data = compressMap != nullptr ? compressMap() : std::vector<uint8_t>();
+        for (size_t i = 0; i < data.size(); i += CHUNK_SIZE)
+        {
+            size_t datasize = std::min<size_t>(CHUNK_SIZE, data.size() - i);
+            std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+            *packet << (uint32_t)NETWORK_COMMAND_MAP << (uint32_t)data.size() << (uint32_t)i;
+            packet->Write(&data[i], datasize);
+            SendPacketToClients(*packet);
+        }
+        // Nobody can continue a game state from before the new map.
+        ResetResyncHistory();
+        return;
     }
 
-    size_t out_size;
-    uint8_t* header = save_for_network(out_size, objects);
-    if (header == nullptr)
+    MapReceiver receiver;
+    receiver.Connection = connection;
+    if (!GetObjectPayloads(objects, receiver.Objects))
     {
-        if (connection)
+        connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+        connection->Socket->Disconnect();
+        return;
+    }
+
+    // Clients joining shortly after each other share the same compressed map, the objects they lack are sent
+    // separately ahead of it.
+    auto it = std::find_if(_mapPayloads.rbegin(), _mapPayloads.rend(), [this](const MapPayload& payload) {
+        return IsMapPayloadCurrent(payload);
+    }).base();
+    if (it == _mapPayloads.begin())
+    {
+        auto compressMap = SaveMap({});
+        if (compressMap == nullptr)
         {
             connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
             connection->Socket->Disconnect();
+            return;
         }
-        return;
+
+        MapPayload payload;
+        payload.Tick = gCurrentTicks;
+        payload.Sequence = _resyncHistory.GetSequence();
+        payload.Pending = std::async(std::launch::async, std::move(compressMap));
+        it = _mapPayloads.insert(_mapPayloads.end(), std::move(payload));
+    }
+    else
+    {
+        it--;
+    }
+
+    // Hold back everything queued from now on until the objects and the map have been queued. The game stream sent
+    // since the map was captured goes first so the client catches up to the current tick.
+    connection->HoldPackets();
+    for (const auto& historyPayload : _resyncHistory.GetPacketsSince(it->Sequence))
+    {
+        connection->QueuePacket(historyPayload);
+    }
+
+    if (!SendMapPayload(*it, receiver))
+    {
+        it->Receivers.push_back(std::move(receiver));
     }
-    size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < out_size; i += chunksize)
+}
+
+bool Network::IsMapPayloadCurrent(const MapPayload& payload) const
+{
+    // Failed maps are not reused, and the client has to be able to catch up from the history. A relay passes the game
+    // stream on without keeping a history, so its spectators always need a map of their own.
+    if (mode != NETWORK_MODE_SERVER || (!payload.Pending.valid() && payload.Packets.empty()))
     {
-        size_t datasize = std::min(chunksize, out_size - i);
-        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-        *packet << (uint32_t)NETWORK_COMMAND_MAP << (uint32_t)out_size << (uint32_t)i;
-        packet->Write(&header[i], datasize);
-        if (connection)
+        return false;
+    }
+    return payload.Tick + NETWORK_MAP_PAYLOAD_TICKS >= gCurrentTicks
+        && _resyncHistory.Contains(payload.Sequence);
+}
+
+void Network::ClearMapPayloads()
+{
+    // Whatever was held back for clients still waiting for one of these maps belongs to the previous map.
+    for (auto& payload : _mapPayloads)
+    {
+        for (auto& receiver : payload.Receivers)
         {
-            connection->QueuePacket(std::move(packet));
+            receiver.Connection->DiscardHeldPackets();
         }
-        else
+    }
+    _mapPayloads.clear();
+}
+
+bool Network::SendMapPayload(const MapPayload& payload, const MapReceiver& receiver)
+{
+    if (payload.Pending.valid())
+    {
+        return false;
+    }
+    for (const auto& object : receiver.Objects)
+    {
+        if (object.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
         {
-            SendPacketToClients(*packet);
+            return false;
+        }
+    }
+
+    auto& connection = *receiver.Connection;
+    bool objectsFailed = std::any_of(receiver.Objects.begin(), receiver.Objects.end(), [](const ObjectPayload& object) {
+        return object.get().empty();
+    });
+    if (payload.Packets.empty() || objectsFailed)
+    {
+        // Without all of its objects the client could not load the map.
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+        connection.Socket->Disconnect();
+    }
+    else
+    {
+        for (const auto& object : receiver.Objects)
+        {
+            for (const auto& objectPacket : object.get())
+            {
+                connection.QueuePacket(objectPacket);
+            }
+        }
+        log_verbose("Sending map of %u packets", payload.Packets.size());
+        for (const auto& mapPacket : payload.Packets)
+        {
+            connection.QueuePacket(mapPacket);
         }
     }
-    free(header);
+    connection.ReleasePackets();
+    return true;
 }
 
-uint8_t* Network::save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const
+bool Network::GetObjectPayloads(
+    const std::vector<const ObjectRepositoryItem*>& objects, std::vector<ObjectPayload>& payloads)
 {
-    uint8_t* header = nullptr;
-    out_size = 0;
-    bool RLEState = gUseRLE;
-    gUseRLE = false;
+    // The repository belongs to the game thread, so the objects are read here and only compressed on the worker.
+    auto& repo = GetContext()->GetObjectRepository();
+    std::vector<std::tuple<std::string, MemoryStream, std::promise<std::vector<NetworkPacketPayloadPtr>>>> missing;
+    for (auto object : objects)
+    {
+        auto name = std::string(object->ObjectEntry.name, 8);
+        auto key = std::make_pair(name, object->ObjectEntry.checksum);
+        auto it = _objectPayloads.find(key);
+        if (it == _objectPayloads.end())
+        {
+            MemoryStream stream;
+            try
+            {
+                std::vector<const ObjectRepositoryItem*> packedObjects = { object };
+                repo.WritePackedObjects(&stream, packedObjects);
+            }
+            catch (const std::exception& e)
+            {
+                log_warning("Failed to pack object %s: %s", name.c_str(), e.what());
+                return false;
+            }
+
+            std::promise<std::vector<NetworkPacketPayloadPtr>> promise;
+            it = _objectPayloads.emplace(key, promise.get_future().share()).first;
+            missing.emplace_back(name, std::move(stream), std::move(promise));
+        }
+        payloads.push_back(it->second);
+    }
 
-    auto ms = MemoryStream();
-    if (!SaveMap(&ms, objects))
+    if (!missing.empty())
     {
-        log_warning("Failed to export map.");
-        return nullptr;
+        // Compress everything this client is the first to request on a single worker thread.
+        _objectPackers.push_back(std::async(std::launch::async, [missing = std::move(missing)]() mutable {
+            for (auto& object : missing)
+            {
+                std::get<2>(object).set_value(CreateObjectPackets(std::get<0>(object), std::get<1>(object)));
+            }
+        }));
+    }
+    return true;
+}
+
+std::vector<NetworkPacketPayloadPtr> Network::CreateObjectPackets(const std::string& name, const MemoryStream& data)
+{
+    std::vector<NetworkPacketPayloadPtr> packets;
+    size_t size = (size_t)data.GetLength();
+    size_t compressedSize = 0;
+    uint8_t* compressed = util_zlib_deflate((const uint8_t*)data.GetData(), size, &compressedSize);
+    if (compressed == nullptr)
+    {
+        log_warning("Failed to compress object %s", name.c_str());
+        return packets;
     }
-    gUseRLE = RLEState;
 
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
+    log_verbose("Packed object %s, %u bytes compressed to %u bytes", name.c_str(), size, compressedSize);
+    for (size_t i = 0; i < compressedSize; i += CHUNK_SIZE)
+    {
+        size_t datasize = std::min<size_t>(CHUNK_SIZE, compressedSize - i);
+        NetworkPacket packet;
+        packet << (uint32_t)NETWORK_COMMAND_OBJECT_DATA << (uint32_t)compressedSize << (uint32_t)size << (uint32_t)i;
+        packet.Write(&compressed[i], datasize);
+        packets.push_back(std::make_shared<const NetworkPacketPayload>(packet));
+    }
+    free(compressed);
+    return packets;
+}
+
+std::vector<NetworkPacketPayloadPtr> Network::CreateMapPackets(const std::vector<uint8_t>& data)
+{
+    std::vector<NetworkPacketPayloadPtr> packets;
+    for (size_t i = 0; i < data.size(); i += CHUNK_SIZE)
+    {
+        size_t datasize = std::min<size_t>(CHUNK_SIZE, data.size() - i);
+        NetworkPacket packet;
+        packet << (uint32_t)NETWORK_COMMAND_MAP << (uint32_t)data.size() << (uint32_t)i;
+        packet.Write(&data[i], datasize);
+        packets.push_back(std::make_shared<const NetworkPacketPayload>(packet));
+    }
+    return packets;
+}
 
-    uint8_t* compressed = util_zlib_deflate((const uint8_t*)data, size, &out_size);
-    if (compressed != nullptr)
+void Network::UpdateMapPayloads()
+{
+    for (auto it = _mapPayloads.begin(); it != _mapPayloads.end();)
     {
-        header = (uint8_t*)_strdup("open2_sv6_zlib");
-        size_t header_len = strlen((char*)header) + 1; // account for null terminator
-        header = (uint8_t*)realloc(header, header_len + out_size);
-        if (header == nullptr)
+        auto& payload = *it;
+        if (payload.Pending.valid())
         {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
+            if (payload.Pending.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+            {
+                it++;
+                continue;
+            }
+            payload.Packets = CreateMapPackets(payload.Pending.get());
+        }
+
+        // Receivers keep waiting until their objects are ready as well.
+        auto& receivers = payload.Receivers;
+        receivers.erase(
+            std::remove_if(
+                receivers.begin(), receivers.end(),
+                [this, &payload](const MapReceiver& receiver) { return SendMapPayload(payload, receiver); }),
+            receivers.end());
+
+        // Only keep the map around for as long as new clients can catch up from it.
+        if (receivers.empty() && !IsMapPayloadCurrent(payload))
+        {
+            it = _mapPayloads.erase(it);
         }
         else
         {
-            std::memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
+            it++;
         }
-        free(compressed);
     }
-    else
+
+    _objectPackers.remove_if([](const std::future<void>& packer) {
+        return packer.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+    });
+
+    // Objects that failed to compress are tried again for the next client instead of being cached.
+    for (auto it = _objectPayloads.begin(); it != _objectPayloads.end();)
     {
-        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = (uint8_t*)malloc(size);
-        if (header == nullptr)
+        auto& object = it->second;
+        if (object.wait_for(std::chrono::seconds::zero()) == std::future_status::ready && object.get().empty())
         {
-            log_error("Failed to allocate %u bytes.", size);
+            it = _objectPayloads.erase(it);
         }
         else
         {
-            out_size = size;
-            std::memcpy(header, data, size);
+            it++;
+        }
+    }
+}
+
+void Network::Relay_QueuePacket(const NetworkPacket& packet)
+{
+    _relayPackets.Push(packet);
+}
+
+void Network::Relay_SendPackets()
+{
+    NetworkRelayPacket relayPacket;
+    while (_relayPackets.Pop(gCurrentTicks, relayPacket))
+    {
+        for (auto& connection : client_connection_list)
+        {
+            if (connection->IsSpectating && !connection->IsDisconnected)
+            {
+                connection->QueuePacket(relayPacket.Payload);
+            }
+        }
+    }
+}
+
+void Network::Relay_RestartSpectators()
+{
+    // The server sent a new map, nothing received for the previous one is of any use to the spectators anymore.
+    _relayPackets.Clear();
+
+    auto objects = GetContext()->GetObjectManager().GetPackableObjects();
+    for (auto& connection : client_connection_list)
+    {
+        if (connection->AuthStatus == NETWORK_AUTH_OK && !connection->IsDisconnected)
+        {
+            // The spectator requests the map again once it has received the list of objects.
+            connection->IsSpectating = false;
+            Server_Send_OBJECTS(*connection, objects);
         }
     }
-    return header;
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1687,10 +2214,16 @@ void Network::Server_Send_GAMECMD(
     uint32_t eax, uint32_t ebx, uint32_t ecx, uint32_t edx, uint32_t esi, uint32_t edi, uint32_t ebp, uint8_t playerid,
     uint8_t callback)
 {
+    // Legacy game commands are not batched, clients must still receive them in the order they were executed.
+    if (_tickBatchPending && _tickBatch.GetNumActions() != 0)
+    {
+        Server_Send_TICK_BATCH();
+    }
+
     std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
     *packet << (uint32_t)NETWORK_COMMAND_GAMECMD << gCurrentTicks << eax << (ebx | GAME_COMMAND_FLAG_NETWORKED) << ecx << edx
             << esi << edi << ebp << playerid << callback;
-    SendPacketToClients(*packet, false, true);
+    SendGameStreamPacket(*packet, gCurrentTicks, true);
 }
 
 void Network::Client_Send_GAME_ACTION(const GameAction* action)
@@ -1716,20 +2249,35 @@ void Network::Client_Send_GAME_ACTION(const GameAction* action)
 
 void Network::Server_Send_GAME_ACTION(const GameAction* action)
 {
-    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-
     DataSerialiser stream(true);
     action->Serialise(stream);
 
+    if (_tickBatchPending && _tickBatch.Tick == gCurrentTicks)
+    {
+        auto data = (const uint8_t*)stream.GetStream().GetData();
+        if (_tickBatch.AddAction(action->GetType(), data, stream.GetStream().GetLength()))
+        {
+            return;
+        }
+
+        // The batch is full, send it now so the remaining actions of the tick still arrive in order after it.
+        Server_Send_TICK_BATCH();
+    }
+
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
     *packet << (uint32_t)NETWORK_COMMAND_GAME_ACTION << gCurrentTicks << action->GetType() << stream;
 
-    SendPacketToClients(*packet);
+    SendGameStreamPacket(*packet, gCurrentTicks);
 }
 
 void Network::Server_Send_TICK()
 {
-    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-    *packet << (uint32_t)NETWORK_COMMAND_TICK << gCurrentTicks << scenario_rand_state().s0;
+    // A tick that was never flushed still has to reach the clients before the next one.
+    if (_tickBatchPending)
+    {
+        Server_Send_TICK_BATCH();
+    }
+
     uint32_t flags = 0;
     // Simple counter which limits how often a sprite checksum gets sent.
     // This can get somewhat expensive, so we don't want to push it every tick in release,
@@ -1741,16 +2289,23 @@ void Network::Server_Send_TICK()
         checksum_counter = 0;
         flags |= NETWORK_TICK_FLAG_CHECKSUMS;
     }
-    // Send flags always, so we can understand packet structure on the other end,
-    // and allow for some expansion.
-    *packet << flags;
+    // The checksum has to be taken now, before the tick runs, that is the state the clients compare it against.
+    std::string checksum;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
-        packet->WriteString(checksum.ToString().c_str());
+        checksum = sprite_checksum().ToString();
+        _resyncHistory.SetHash(gCurrentTicks, checksum);
     }
 
-    SendPacketToClients(*packet);
+    _tickBatch.Reset(gCurrentTicks, scenario_rand_state().s0, flags, checksum);
+    _tickBatchPending = true;
+}
+
+void Network::Server_Send_TICK_BATCH()
+{
+    _tickBatchPending = false;
+    auto packet = _tickBatch.CreatePacket();
+    SendGameStreamPacket(*packet, _tickBatch.Tick);
 }
 
 void Network::Server_Send_PLAYERINFO(int32_t playerId)
@@ -1763,7 +2318,7 @@ void Network::Server_Send_PLAYERINFO(int32_t playerId)
         return;
 
     player->Write(*packet);
-    SendPacketToClients(*packet);
+    SendGameStreamPacket(*packet, gCurrentTicks);
 }
 
 void Network::Server_Send_PLAYERLIST()
@@ -1774,7 +2329,7 @@ void Network::Server_Send_PLAYERLIST()
     {
         player->Write(*packet);
     }
-    SendPacketToClients(*packet);
+    SendGameStreamPacket(*packet, gCurrentTicks);
 }
 
 void Network::Client_Send_PING()
@@ -1815,6 +2370,122 @@ void Network::Server_Send_SETDISCONNECTMSG(NetworkConnection& connection, const
     connection.QueuePacket(std::move(packet));
 }
 
+std::vector<std::pair<std::string, NetworkStats_t>> Network::GetConnectionStats() const
+{
+    std::vector<std::pair<std::string, NetworkStats_t>> result;
+    if (mode == NETWORK_MODE_CLIENT)
+    {
+        result.emplace_back(_host, _serverConnection->GetStats());
+    }
+    else
+    {
+        for (auto& connection : client_connection_list)
+        {
+            std::string name;
+            if (connection->Player != nullptr)
+            {
+                name = connection->Player->Name;
+            }
+            else if (connection->Socket->GetHostName() != nullptr)
+            {
+                name = connection->Socket->GetHostName();
+            }
+            result.emplace_back(name, connection->GetStats());
+        }
+    }
+    return result;
+}
+
+static json_t* GetHistogramAsJson(const NetworkHistogram_t& histogram)
+{
+    json_t* jsonBuckets = json_array();
+    for (size_t i = 0; i < NETWORK_HISTOGRAM_BUCKETS; i++)
+    {
+        json_t* jsonBucket = json_object();
+        // The last bucket has no upper limit.
+        if (i < NETWORK_HISTOGRAM_BUCKETS - 1)
+        {
+            json_object_set_new(jsonBucket, "below", json_integer(NetworkHistogram_t::GetBucketLimit(i)));
+        }
+        json_object_set_new(jsonBucket, "count", json_integer((json_int_t)histogram.buckets[i]));
+        json_array_append_new(jsonBuckets, jsonBucket);
+    }
+
+    json_t* obj = json_object();
+    json_object_set_new(obj, "count", json_integer((json_int_t)histogram.count));
+    json_object_set_new(obj, "average", json_real(histogram.count == 0 ? 0.0 : (double)histogram.sum / histogram.count));
+    json_object_set_new(obj, "max", json_integer(histogram.max));
+    json_object_set_new(obj, "buckets", jsonBuckets);
+    return obj;
+}
+
+static json_t* GetStatsAsJson(const NetworkStats_t& stats)
+{
+    json_t* jsonCommands = json_object();
+    for (int32_t i = 0; i < NETWORK_COMMAND_MAX; i++)
+    {
+        const auto& commandStats = stats.commands[i];
+        if (commandStats.packetsReceived == 0 && commandStats.packetsSent == 0)
+        {
+            continue;
+        }
+
+        json_t* jsonCommand = json_object();
+        json_object_set_new(jsonCommand, "packetsReceived", json_integer((json_int_t)commandStats.packetsReceived));
+        json_object_set_new(jsonCommand, "bytesReceived", json_integer((json_int_t)commandStats.bytesReceived));
+        json_object_set_new(jsonCommand, "packetsSent", json_integer((json_int_t)commandStats.packetsSent));
+        json_object_set_new(jsonCommand, "bytesSent", json_integer((json_int_t)commandStats.bytesSent));
+        json_object_set_new(jsonCommands, network_get_command_name(i), jsonCommand);
+    }
+
+    json_t* obj = json_object();
+    json_object_set_new(
+        obj, "bytesReceived", json_integer((json_int_t)stats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL]));
+    json_object_set_new(obj, "bytesSent", json_integer((json_int_t)stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL]));
+    json_object_set_new(obj, "commands", jsonCommands);
+    json_object_set_new(obj, "sendQueueDepth", GetHistogramAsJson(stats.sendQueueDepth));
+    json_object_set_new(obj, "roundTripTime", GetHistogramAsJson(stats.roundTripTime));
+    return obj;
+}
+
+json_t* Network::GetStatsAsJson() const
+{
+    json_t* jsonConnections = json_array();
+    for (const auto& connectionStats : GetConnectionStats())
+    {
+        json_t* jsonConnection = json_object();
+        json_object_set_new(jsonConnection, "name", json_string(connectionStats.first.c_str()));
+        json_object_set_new(jsonConnection, "stats", ::GetStatsAsJson(connectionStats.second));
+        json_array_append_new(jsonConnections, jsonConnection);
+    }
+
+    json_t* obj = json_object();
+    json_object_set_new(obj, "time", json_integer((json_int_t)platform_get_datetime_now_utc()));
+    json_object_set_new(obj, "tick", json_integer(gCurrentTicks));
+    json_object_set_new(obj, "total", ::GetStatsAsJson(GetStats()));
+    json_object_set_new(obj, "connections", jsonConnections);
+    return obj;
+}
+
+std::string Network::DumpStats() const
+{
+    auto directory = _env->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_SERVER);
+    auto path = Path::Combine(directory, "network_stats.json");
+    json_t* json = GetStatsAsJson();
+    try
+    {
+        platform_ensure_directory_exists(directory.c_str());
+        Json::WriteToFile(path.c_str(), json, JSON_INDENT(4) | JSON_PRESERVE_ORDER);
+    }
+    catch (const std::exception& ex)
+    {
+        log_error("Unable to write network stats to %s: %s", path.c_str(), ex.what());
+        path.clear();
+    }
+    json_decref(json);
+    return path;
+}
+
 json_t* Network::GetServerInfoAsJson() const
 {
     json_t* obj = json_object();
@@ -1920,6 +2591,11 @@ bool Network::ProcessConnection(NetworkConnection& connection)
         }
     } while (packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS);
     connection.SendQueuedPackets();
+    return CheckConnectionTimeout(connection);
+}
+
+bool Network::CheckConnectionTimeout(NetworkConnection& connection)
+{
     if (!connection.ReceivedPacketRecently())
     {
         if (!connection.GetLastDisconnectReason())
@@ -1931,6 +2607,47 @@ bool Network::ProcessConnection(NetworkConnection& connection)
     return true;
 }
 
+void Network::ProcessIoEvents()
+{
+    NetworkIoEvent e;
+    while (_ioThread->PollEvent(e))
+    {
+        if (e.Type == NETWORK_IO_EVENT_ACCEPTED)
+        {
+            AddClient(std::move(e.AcceptedConnection));
+            continue;
+        }
+        if (e.Type == NETWORK_IO_EVENT_RELEASED)
+        {
+            _releasingConnections.remove_if([&e](const auto& connection) { return connection.get() == e.Connection; });
+            continue;
+        }
+
+        // Events of connections that have been removed in the meantime are of no interest.
+        auto it = std::find_if(client_connection_list.begin(), client_connection_list.end(), [&e](const auto& connection) {
+            return connection.get() == e.Connection;
+        });
+        if (it == client_connection_list.end() || (*it)->IsDisconnected)
+        {
+            continue;
+        }
+
+        auto& connection = **it;
+        if (e.Type == NETWORK_IO_EVENT_PACKET)
+        {
+            ProcessPacket(connection, *e.Packet);
+        }
+        else if (e.Type == NETWORK_IO_EVENT_DISCONNECTED)
+        {
+            if (!connection.GetLastDisconnectReason())
+            {
+                connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            }
+            connection.IsDisconnected = true;
+        }
+    }
+}
+
 void Network::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t command;
@@ -1949,8 +2666,23 @@ void Network::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet
                 }
                 break;
             case NETWORK_MODE_CLIENT:
-                if (client_command_handlers[command])
+                if (&connection != _serverConnection.get())
+                {
+                    // Spectators connected to the relay.
+                    if (relay_command_handlers[command])
+                    {
+                        if (connection.AuthStatus == NETWORK_AUTH_OK || !packet.CommandRequiresAuth())
+                        {
+                            (this->*relay_command_handlers[command])(connection, packet);
+                        }
+                    }
+                }
+                else if (client_command_handlers[command])
                 {
+                    if (_relayPort != 0)
+                    {
+                        Relay_QueuePacket(packet);
+                    }
                     (this->*client_command_handlers[command])(connection, packet);
                 }
                 break;
@@ -1962,6 +2694,12 @@ void Network::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet
 // This is called at the end of each game tick, this where things should be processed that affects the game state.
 void Network::ProcessPending()
 {
+    if (_processedTick != gCurrentTicks)
+    {
+        // A tick has run since, none of the game commands of the current one have yet.
+        _processedCommands = 0;
+        _processedCommandsKnown = true;
+    }
     ProcessGameCommands();
     if (GetMode() == NETWORK_MODE_SERVER)
     {
@@ -1972,6 +2710,13 @@ void Network::ProcessPending()
         ProcessPlayerInfo();
     }
     ProcessPlayerList();
+    _processedTick = gCurrentTicks;
+
+    if (GetMode() == NETWORK_MODE_CLIENT && _relayPort != 0)
+    {
+        ProcessDisconnectedClients();
+        Relay_SendPackets();
+    }
 }
 
 void Network::ProcessPlayerList()
@@ -2074,6 +2819,22 @@ void Network::ProcessDisconnectedClients()
             ServerClientDisconnected(connection);
             RemovePlayer(connection);
 
+            for (auto& payload : _mapPayloads)
+            {
+                auto& receivers = payload.Receivers;
+                receivers.erase(
+                    std::remove_if(
+                        receivers.begin(), receivers.end(),
+                        [&connection](const MapReceiver& receiver) { return receiver.Connection == connection.get(); }),
+                    receivers.end());
+            }
+
+            if (connection->UsesIoThread)
+            {
+                // Only destroy the connection once the I/O thread has let go of it.
+                _ioThread->Release(*connection);
+                _releasingConnections.push_back(std::move(connection));
+            }
             it = client_connection_list.erase(it);
         }
         else
@@ -2082,7 +2843,8 @@ void Network::ProcessDisconnectedClients()
         }
     }
 
-    if (gConfigNetwork.pause_server_if_no_clients && game_is_not_paused() && client_connection_list.empty())
+    if (GetMode() == NETWORK_MODE_SERVER && gConfigNetwork.pause_server_if_no_clients && game_is_not_paused()
+        && client_connection_list.empty())
     {
         auto pauseToggleAction = PauseToggleAction();
         GameActions::Execute(&pauseToggleAction);
@@ -2115,6 +2877,8 @@ void Network::ProcessGameCommands()
             // exit the game command processing loop to still have a chance at finding desync.
             if (game_command_queue.begin()->tick != gCurrentTicks)
                 break;
+
+            _processedCommands++;
         }
 
         if (gc.action != nullptr)
@@ -2136,7 +2900,7 @@ void Network::ProcessGameCommands()
             Guard::Assert(action != nullptr);
 
             GameActionResult::Ptr result = GameActions::Execute(action);
-            if (result->Error == GA_ERROR::OK)
+            if (result->Error == GA_ERROR::OK && mode == NETWORK_MODE_SERVER)
             {
                 Server_Send_GAME_ACTION(action);
                 Server_Send_PLAYERINFO(action->GetPlayer());
@@ -2202,9 +2966,9 @@ void Network::EnqueueGameAction(const GameAction* action)
     game_command_queue.emplace(gCurrentTicks, std::move(ga), _commandId++);
 }
 
-void Network::AddClient(std::unique_ptr<ITcpSocket>&& socket)
+void Network::AddClient(std::unique_ptr<NetworkConnection>&& connection)
 {
-    if (gConfigNetwork.pause_server_if_no_clients && game_is_paused())
+    if (GetMode() == NETWORK_MODE_SERVER && gConfigNetwork.pause_server_if_no_clients && game_is_paused())
     {
         auto pauseToggleAction = PauseToggleAction();
         GameActions::Execute(&pauseToggleAction);
@@ -2212,13 +2976,10 @@ void Network::AddClient(std::unique_ptr<ITcpSocket>&& socket)
 
     // Log connection info.
     char addr[128];
-    snprintf(addr, sizeof(addr), "Client joined from %s", socket->GetHostName());
+    snprintf(addr, sizeof(addr), "Client joined from %s", connection->Socket->GetHostName());
     AppendServerLog(addr);
 
     // Store connection
-    auto connection = std::make_unique<NetworkConnection>();
-    connection->Socket = std::move(socket);
-
     client_connection_list.push_back(std::move(connection));
 }
 
@@ -2593,7 +3354,14 @@ void Network::Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
                 ori->ObjectEntry.flags, checksum, flags);
         }
     }
-    Client_Send_OBJECTS(requested_objects);
+    if (requested_objects.empty() && _resyncMap.valid())
+    {
+        Client_Send_RESYNC(requested_objects);
+    }
+    else
+    {
+        Client_Send_OBJECTS(requested_objects);
+    }
 }
 
 void Network::Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
@@ -2663,7 +3431,8 @@ void Network::Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPack
     }
 }
 
-void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet)
+bool Network::ReadObjectRequest(
+    NetworkConnection& connection, NetworkPacket& packet, std::vector<const ObjectRepositoryItem*>& objects)
 {
     uint32_t size;
     packet >> size;
@@ -2679,7 +3448,7 @@ void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
         std::string text = std::string("Player ") + playerName + std::string(" requested invalid amount of objects");
         AppendServerLog(text);
         log_warning(text.c_str());
-        return;
+        return false;
     }
     log_verbose("Client requested %u objects", size);
     auto& repo = GetContext()->GetObjectRepository();
@@ -2696,16 +3465,46 @@ void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
         }
         else
         {
-            connection.RequestedObjects.push_back(item);
+            objects.push_back(item);
         }
     }
+    return true;
+}
+
+void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    std::vector<const ObjectRepositoryItem*> objects;
+    if (!ReadObjectRequest(connection, packet, objects))
+    {
+        return;
+    }
 
     const char* player_name = (const char*)connection.Player->Name.c_str();
-    Server_Send_MAP(&connection);
+    Server_Send_MAP(&connection, objects);
     Server_Send_EVENT_PLAYER_JOINED(player_name);
     Server_Send_GROUPLIST(connection);
 }
 
+void Network::Server_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick, commands, confirmedTick;
+    packet >> tick >> commands >> confirmedTick;
+    const char* confirmedHash = packet.ReadString();
+    std::vector<const ObjectRepositoryItem*> objects;
+    if (confirmedHash == nullptr || !ReadObjectRequest(connection, packet, objects))
+    {
+        return;
+    }
+
+    // The map is the fallback whenever the game state of the client can not be continued.
+    if (!objects.empty() || !Server_Send_RESYNC(connection, tick, commands, confirmedTick, confirmedHash))
+    {
+        Server_Send_MAP(&connection, objects);
+    }
+    Server_Send_EVENT_PLAYER_JOINED(connection.Player->Name.c_str());
+    Server_Send_GROUPLIST(connection);
+}
+
 void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
 {
     if (connection.AuthStatus != NETWORK_AUTH_OK)
@@ -2813,6 +3612,141 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
     }
 }
 
+void Network::Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus == NETWORK_AUTH_OK)
+    {
+        return;
+    }
+
+    // Spectators can not act on the game, so neither their key nor a password need to be verified.
+    const char* gameversion = packet.ReadString();
+    if (gameversion == nullptr || network_get_version() != gameversion)
+    {
+        connection.AuthStatus = NETWORK_AUTH_BADVERSION;
+    }
+    else
+    {
+        connection.AuthStatus = NETWORK_AUTH_OK;
+    }
+    Server_Send_AUTH(connection);
+
+    // Without a map of its own yet, the relay sends the objects once it has received it.
+    if (connection.AuthStatus == NETWORK_AUTH_OK && _clientMapLoaded)
+    {
+        Server_Send_OBJECTS(connection, GetContext()->GetObjectManager().GetPackableObjects());
+    }
+}
+
+void Network::Relay_Handle_GAMEINFO(NetworkConnection& connection, [[maybe_unused]] NetworkPacket& packet)
+{
+    std::unique_ptr<NetworkPacket> infoPacket(NetworkPacket::Allocate());
+    *infoPacket << (uint32_t)NETWORK_COMMAND_GAMEINFO;
+#    ifndef DISABLE_HTTP
+    // Spectators are shown the details of the server being relayed.
+    json_t* obj = json_object();
+    json_object_set_new(obj, "name", json_string(ServerName.c_str()));
+    json_object_set_new(obj, "description", json_string(ServerDescription.c_str()));
+    json_object_set_new(obj, "greeting", json_string(ServerGreeting.c_str()));
+
+    json_t* jsonProvider = json_object();
+    json_object_set_new(jsonProvider, "name", json_string(ServerProviderName.c_str()));
+    json_object_set_new(jsonProvider, "email", json_string(ServerProviderEmail.c_str()));
+    json_object_set_new(jsonProvider, "website", json_string(ServerProviderWebsite.c_str()));
+    json_object_set_new(obj, "provider", jsonProvider);
+
+    infoPacket->WriteString(json_dumps(obj, 0));
+    // The relay does not keep a game state history to request.
+    *infoPacket << false;
+
+    json_decref(obj);
+#    endif
+    connection.QueuePacket(std::move(infoPacket));
+}
+
+void Network::Relay_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus != NETWORK_AUTH_OK || connection.IsSpectating || !_clientMapLoaded)
+    {
+        return;
+    }
+
+    std::vector<const ObjectRepositoryItem*> objects;
+    if (!ReadObjectRequest(connection, packet, objects))
+    {
+        return;
+    }
+
+    // The map is captured now, everything the relay passes on from here on follows it.
+    connection.IsSpectating = true;
+    Server_Send_MAP(&connection, objects);
+    Server_Send_GROUPLIST(connection);
+
+    std::unique_ptr<NetworkPacket> playerList(NetworkPacket::Allocate());
+    *playerList << (uint32_t)NETWORK_COMMAND_PLAYERLIST << gCurrentTicks << (uint8_t)player_list.size();
+    for (auto& player : player_list)
+    {
+        player->Write(*playerList);
+    }
+    connection.QueuePacket(std::move(playerList));
+}
+
+void Network::Relay_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet)
+{
+    // The relay keeps no history, spectators always receive the map again.
+    uint32_t tick, commands, confirmedTick;
+    packet >> tick >> commands >> confirmedTick;
+    if (packet.ReadString() != nullptr)
+    {
+        Relay_Handle_OBJECTS(connection, packet);
+    }
+}
+
+void Network::Client_Handle_OBJECT_DATA([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t size, uncompressedSize, offset;
+    packet >> size >> uncompressedSize >> offset;
+    if (offset == 0)
+    {
+        _objectData.clear();
+    }
+
+    size_t chunksize = packet.Size - packet.BytesRead;
+    const uint8_t* chunk = packet.Read(chunksize);
+    if (chunk == nullptr || offset != _objectData.size() || offset + chunksize > size)
+    {
+        log_warning("Received object data out of order");
+        _objectData.clear();
+        return;
+    }
+    _objectData.insert(_objectData.end(), chunk, chunk + chunksize);
+    if (_objectData.size() < size)
+    {
+        return;
+    }
+
+    size_t dataSize = uncompressedSize;
+    uint8_t* data = util_zlib_inflate(_objectData.data(), _objectData.size(), &dataSize);
+    _objectData.clear();
+    if (data == nullptr)
+    {
+        log_warning("Failed to decompress object data");
+        return;
+    }
+
+    // The object is added to the repository just like the ones packed into a saved game.
+    try
+    {
+        auto stream = MemoryStream(data, dataSize);
+        GetContext()->GetObjectRepository().ExportPackedObject(&stream);
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Failed to import object: %s", e.what());
+    }
+    free(data);
+}
+
 void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size, offset;
@@ -2842,46 +3776,18 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
     if (offset + chunksize == size)
     {
         context_force_close_window_by_class(WC_NETWORK_STATUS);
-        bool has_to_free = false;
-        uint8_t* data = &chunk_buffer[0];
-        size_t data_size = size;
-        // zlib-compressed
-        if (strcmp("open2_sv6_zlib", (char*)&chunk_buffer[0]) == 0)
+        auto data = DecompressMap(chunk_buffer.data(), size);
+        if (data.empty())
         {
-            log_verbose("Received zlib-compressed sv6 map");
-            has_to_free = true;
-            size_t header_len = strlen("open2_sv6_zlib") + 1;
-            data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
-            if (data == nullptr)
-            {
-                log_warning("Failed to decompress data sent from server.");
-                Close();
-                return;
-            }
-        }
-        else
-        {
-            log_verbose("Assuming received map is in plain sv6 format");
+            log_warning("Failed to decompress data sent from server.");
+            Close();
+            return;
         }
 
-        auto ms = MemoryStream(data, data_size);
+        auto ms = MemoryStream(data.data(), data.size());
         if (LoadMap(&ms))
         {
-            game_load_init();
-            game_command_queue.clear();
-            _serverTickData.clear();
-            _serverState.tick = gCurrentTicks;
-            _serverTickData.clear();
-            // window_network_status_open("Loaded new map from network");
-            _serverState.state = NETWORK_SERVER_STATE_OK;
-            _clientMapLoaded = true;
-            gFirstTimeSaving = true;
-
-            // Notify user he is now online and which shortcut key enables chat
-            network_chat_show_connected_message();
-
-            // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
-            fix_invalid_vehicle_sprite_sizes();
+            Client_MapLoaded(false);
         }
         else
         {
@@ -2889,11 +3795,111 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
             auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PM_SAVE_BEFORE_QUIT);
             GameActions::Execute(&loadOrQuitAction);
         }
-        if (has_to_free)
+    }
+}
+
+void Network::Client_MapLoaded(bool resumed)
+{
+    game_load_init();
+    game_command_queue.clear();
+    _serverTickData.clear();
+    _serverState.tick = gCurrentTicks;
+    // window_network_status_open("Loaded new map from network");
+    _serverState.state = NETWORK_SERVER_STATE_OK;
+    _clientMapLoaded = true;
+    gFirstTimeSaving = true;
+
+    // A saved game state is of no use anymore once the server has provided one, nor is a map captured for spectators.
+    _resyncMap = {};
+    ClearMapPayloads();
+    _confirmedHash.clear();
+    // A paused game may already contain game commands of the current tick. Only a resumed game state tells how many,
+    // the map of the server does not.
+    _processedTick = game_is_paused() ? gCurrentTicks : gCurrentTicks - 1;
+    _processedCommands = resumed ? _resyncCommands : 0;
+    _processedCommandsKnown = resumed || game_is_not_paused();
+
+    // Notify user he is now online and which shortcut key enables chat
+    network_chat_show_connected_message();
+
+    // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
+    fix_invalid_vehicle_sprite_sizes();
+
+    if (_relayPort != 0)
+    {
+        Relay_RestartSpectators();
+    }
+}
+
+void Network::Client_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    packet >> tick;
+
+    std::vector<uint8_t> data;
+    if (_resyncMap.valid() && tick == _resyncTick)
+    {
+        data = DecompressMap(_resyncMap.get().data(), _resyncMap.get().size());
+    }
+    if (!data.empty())
+    {
+        auto ms = MemoryStream(data.data(), data.size());
+        if (LoadMap(&ms))
         {
-            free(data);
+            log_verbose("Resumed the game state of tick %u", tick);
+            Client_MapLoaded(true);
+            return;
         }
     }
+
+    log_warning("Unable to resume the saved game state, requesting the map.");
+    _resyncMap = {};
+    Client_Send_OBJECTS({});
+}
+
+void Network::Client_SaveResyncPoint()
+{
+    _resyncMap = {};
+    // Only a game state between two ticks that the server has confirmed shortly before can be continued. While the game
+    // is paused the game commands of the next tick are already run before it, the server leaves those out.
+    bool betweenTicks = _processedTick + 1 == gCurrentTicks;
+    bool paused = _processedTick == gCurrentTicks && game_is_paused() && _processedCommandsKnown;
+    if (!_clientMapLoaded || IsDesynchronised() || _confirmedHash.empty() || !(betweenTicks || paused))
+    {
+        return;
+    }
+
+    auto saveMap = SaveMap({});
+    if (saveMap != nullptr)
+    {
+        _resyncMap = std::async(std::launch::async, std::move(saveMap)).share();
+        _resyncTick = gCurrentTicks;
+        _resyncCommands = paused ? _processedCommands : 0;
+        _resyncConfirmedTick = _confirmedTick;
+        _resyncConfirmedHash = _confirmedHash;
+    }
+}
+
+std::vector<uint8_t> Network::DecompressMap(const uint8_t* data, size_t size)
+{
+    const char* header = "open2_sv6_zlib";
+    size_t headerLength = strlen(header) + 1;
+    if (size < headerLength || memcmp(header, data, headerLength) != 0)
+    {
+        log_verbose("Assuming received map is in plain sv6 format");
+        return std::vector<uint8_t>(data, data + size);
+    }
+
+    log_verbose("Received zlib-compressed sv6 map");
+    std::vector<uint8_t> result;
+    size_t dataSize = 0;
+    uint8_t* inflated = util_zlib_inflate(const_cast<uint8_t*>(data + headerLength), size - headerLength, &dataSize);
+    if (inflated != nullptr)
+    {
+        result.assign(inflated, inflated + dataSize);
+        free(inflated);
+    }
+    return result;
 }
 
 bool Network::LoadMap(IStream* stream)
@@ -2949,50 +3955,80 @@ bool Network::LoadMap(IStream* stream)
     return result;
 }
 
-bool Network::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const
+std::function<std::vector<uint8_t>()> Network::SaveMap(const std::vector<const ObjectRepositoryItem*>& objects) const
 {
-    bool result = false;
+    // The game state is written out here, only the compression is left to the returned function so it
+    // can run on a worker thread without touching the game.
     viewport_set_saved_view();
+    bool RLEState = gUseRLE;
+    gUseRLE = false;
     try
     {
-        auto s6exporter = std::make_unique<S6Exporter>();
-        s6exporter->ExportObjectsList = objects;
-        s6exporter->Export();
-        s6exporter->SaveGame(stream);
+        auto ms = std::make_shared<MemoryStream>();
+        S6Exporter s6exporter;
+        s6exporter.ExportObjectsList = objects;
+        s6exporter.Export();
+        s6exporter.SaveGame(ms.get());
+        gUseRLE = RLEState;
 
         // Write other data not in normal save files
-        stream->Write(gSpriteSpatialIndex, 0x10001 * sizeof(uint16_t));
-        stream->WriteValue<uint32_t>(gGamePaused);
-        stream->WriteValue<uint32_t>(_guestGenerationProbability);
-        stream->WriteValue<uint32_t>(_suggestedGuestMaximum);
-        stream->WriteValue<uint8_t>(gCheatsSandboxMode);
-        stream->WriteValue<uint8_t>(gCheatsDisableClearanceChecks);
-        stream->WriteValue<uint8_t>(gCheatsDisableSupportLimits);
-        stream->WriteValue<uint8_t>(gCheatsDisableTrainLengthLimit);
-        stream->WriteValue<uint8_t>(gCheatsEnableChainLiftOnAllTrack);
-        stream->WriteValue<uint8_t>(gCheatsShowAllOperatingModes);
-        stream->WriteValue<uint8_t>(gCheatsShowVehiclesFromOtherTrackTypes);
-        stream->WriteValue<uint8_t>(gCheatsFastLiftHill);
-        stream->WriteValue<uint8_t>(gCheatsDisableBrakesFailure);
-        stream->WriteValue<uint8_t>(gCheatsDisableAllBreakdowns);
-        stream->WriteValue<uint8_t>(gCheatsBuildInPauseMode);
-        stream->WriteValue<uint8_t>(gCheatsIgnoreRideIntensity);
-        stream->WriteValue<uint8_t>(gCheatsDisableVandalism);
-        stream->WriteValue<uint8_t>(gCheatsDisableLittering);
-        stream->WriteValue<uint8_t>(gCheatsNeverendingMarketing);
-        stream->WriteValue<uint8_t>(gCheatsFreezeWeather);
-        stream->WriteValue<uint8_t>(gCheatsDisablePlantAging);
-        stream->WriteValue<uint8_t>(gCheatsAllowArbitraryRideTypeChanges);
-        stream->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
-        stream->WriteValue<uint8_t>(gConfigGeneral.show_real_names_of_guests);
-        stream->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
-
-        result = true;
+        ms->Write(gSpriteSpatialIndex, 0x10001 * sizeof(uint16_t));
+        ms->WriteValue<uint32_t>(gGamePaused);
+        ms->WriteValue<uint32_t>(_guestGenerationProbability);
+        ms->WriteValue<uint32_t>(_suggestedGuestMaximum);
+        ms->WriteValue<uint8_t>(gCheatsSandboxMode);
+        ms->WriteValue<uint8_t>(gCheatsDisableClearanceChecks);
+        ms->WriteValue<uint8_t>(gCheatsDisableSupportLimits);
+        ms->WriteValue<uint8_t>(gCheatsDisableTrainLengthLimit);
+        ms->WriteValue<uint8_t>(gCheatsEnableChainLiftOnAllTrack);
+        ms->WriteValue<uint8_t>(gCheatsShowAllOperatingModes);
+        ms->WriteValue<uint8_t>(gCheatsShowVehiclesFromOtherTrackTypes);
+        ms->WriteValue<uint8_t>(gCheatsFastLiftHill);
+        ms->WriteValue<uint8_t>(gCheatsDisableBrakesFailure);
+        ms->WriteValue<uint8_t>(gCheatsDisableAllBreakdowns);
+        ms->WriteValue<uint8_t>(gCheatsBuildInPauseMode);
+        ms->WriteValue<uint8_t>(gCheatsIgnoreRideIntensity);
+        ms->WriteValue<uint8_t>(gCheatsDisableVandalism);
+        ms->WriteValue<uint8_t>(gCheatsDisableLittering);
+        ms->WriteValue<uint8_t>(gCheatsNeverendingMarketing);
+        ms->WriteValue<uint8_t>(gCheatsFreezeWeather);
+        ms->WriteValue<uint8_t>(gCheatsDisablePlantAging);
+        ms->WriteValue<uint8_t>(gCheatsAllowArbitraryRideTypeChanges);
+        ms->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
+        ms->WriteValue<uint8_t>(gConfigGeneral.show_real_names_of_guests);
+        ms->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
+
+        return [ms]() -> std::vector<uint8_t> {
+            std::vector<uint8_t> result;
+            const uint8_t* data = (const uint8_t*)ms->GetData();
+            size_t size = (size_t)ms->GetLength();
+
+            size_t compressedSize = 0;
+            uint8_t* compressed = util_zlib_deflate(data, size, &compressedSize);
+            if (compressed != nullptr)
+            {
+                const char* header = "open2_sv6_zlib";
+                size_t headerLength = strlen(header) + 1; // account for null terminator
+                result.reserve(headerLength + compressedSize);
+                result.insert(result.end(), header, header + headerLength);
+                result.insert(result.end(), compressed, compressed + compressedSize);
+                free(compressed);
+                log_verbose("Prepared map of size %u bytes, compressed to %u bytes", size, result.size());
+            }
+            else
+            {
+                log_warning("Failed to compress the data, falling back to non-compressed sv6.");
+                result.assign(data, data + size);
+            }
+            return result;
+        };
     }
-    catch (const std::exception&)
+    catch (const std::exception& e)
     {
+        gUseRLE = RLEState;
+        log_warning("Failed to export map: %s", e.what());
     }
-    return result;
+    return nullptr;
 }
 
 void Network::Client_Handle_CHAT([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
@@ -3040,9 +4076,14 @@ void Network::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection& conn
     uint32_t actionType;
     packet >> tick >> actionType;
 
-    MemoryStream stream;
     size_t size = packet.Size - packet.BytesRead;
-    stream.WriteArray(packet.Read(size), size);
+    Client_QueueGameAction(tick, actionType, packet.Read(size), size);
+}
+
+void Network::Client_QueueGameAction(uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size)
+{
+    MemoryStream stream;
+    stream.WriteArray(data, size);
     stream.SetPosition(0);
 
     DataSerialiser ds(false, stream);
@@ -3208,19 +4249,43 @@ void Network::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection,
 
     packet >> serverTick >> srand0 >> flags;
 
-    ServerTickData_t tickData;
-    tickData.srand0 = srand0;
-    tickData.tick = serverTick;
-
+    std::string spriteHash;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
         const char* text = packet.ReadString();
         if (text != nullptr)
         {
-            tickData.spriteHash = text;
+            spriteHash = text;
         }
     }
 
+    Client_ReceiveTick(serverTick, srand0, spriteHash);
+}
+
+void Network::Client_Handle_TICK_BATCH([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    NetworkTickBatch batch;
+    if (!batch.Read(packet))
+    {
+        log_error("Received malformed tick batch for tick %u", batch.Tick);
+        return;
+    }
+
+    for (size_t i = 0; i < batch.GetNumActions(); i++)
+    {
+        auto action = batch.GetAction(i);
+        Client_QueueGameAction(batch.Tick, action.Type, action.Data, action.Size);
+    }
+    Client_ReceiveTick(batch.Tick, batch.Srand0, batch.Checksum);
+}
+
+void Network::Client_ReceiveTick(uint32_t serverTick, uint32_t srand0, const std::string& spriteHash)
+{
+    ServerTickData_t tickData;
+    tickData.srand0 = srand0;
+    tickData.tick = serverTick;
+    tickData.spriteHash = spriteHash;
+
     // Don't let the history grow too much.
     while (_serverTickData.size() >= 100)
     {
@@ -3272,6 +4337,7 @@ void Network::Server_Handle_PING(NetworkConnection& connection, [[maybe_unused]]
     {
         ping = 0;
     }
+    connection.RecordRoundTripTime(ping);
     if (connection.Player)
     {
         connection.Player->Ping = ping;
@@ -3435,6 +4501,11 @@ int32_t network_begin_server(int32_t port, const std::string& address)
     return gNetwork.BeginServer(port, address);
 }
 
+int32_t network_begin_relay(const std::string& host, int32_t port, int32_t listenPort, const std::string& address)
+{
+    return gNetwork.BeginRelay(host, port, listenPort, address);
+}
+
 void network_update()
 {
     gNetwork.Update();
@@ -4112,11 +5183,56 @@ std::string network_get_version()
     return NETWORK_STREAM_ID;
 }
 
+const char* network_get_command_name(int32_t command)
+{
+    static constexpr const char* CommandNames[] = {
+        "AUTH",
+        "MAP",
+        "CHAT",
+        "GAMECMD",
+        "TICK",
+        "PLAYERLIST",
+        "PING",
+        "PINGLIST",
+        "SETDISCONNECTMSG",
+        "GAMEINFO",
+        "SHOWERROR",
+        "GROUPLIST",
+        "EVENT",
+        "TOKEN",
+        "OBJECTS",
+        "GAME_ACTION",
+        "PLAYERINFO",
+        "REQUEST_GAMESTATE",
+        "GAMESTATE",
+        "TICK_BATCH",
+        "OBJECT_DATA",
+        "RESYNC",
+    };
+    static_assert(std::size(CommandNames) == NETWORK_COMMAND_MAX, "Every command needs a name");
+
+    if (command < 0 || command >= NETWORK_COMMAND_MAX)
+    {
+        return "UNKNOWN";
+    }
+    return CommandNames[command];
+}
+
 NetworkStats_t network_get_stats()
 {
     return gNetwork.GetStats();
 }
 
+std::vector<std::pair<std::string, NetworkStats_t>> network_get_connection_stats()
+{
+    return gNetwork.GetConnectionStats();
+}
+
+std::string network_dump_stats()
+{
+    return gNetwork.DumpStats();
+}
+
 NetworkServerState_t network_get_server_state()
 {
     return gNetwork.GetServerState();
@@ -4196,6 +5312,10 @@ int32_t network_begin_server(int32_t port, const std::string& address)
 {
     return 1;
 }
+int32_t network_begin_relay(const std::string& host, int32_t port, int32_t listenPort, const std::string& address)
+{
+    return 1;
+}
 int32_t network_get_num_players()
 {
     return 1;
@@ -4383,10 +5503,22 @@ std::string network_get_version()
 {
     return "Multiplayer disabled";
 }
+const char* network_get_command_name(int32_t command)
+{
+    return "UNKNOWN";
+}
 NetworkStats_t network_get_stats()
 {
     return NetworkStats_t{};
 }
+std::vector<std::pair<std::string, NetworkStats_t>> network_get_connection_stats()
+{
+    return {};
+}
+std::string network_dump_stats()
+{
+    return {};
+}
 NetworkServerState_t network_get_server_state()
 {
     return NetworkServerState_t{};
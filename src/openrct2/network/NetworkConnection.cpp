@@ -17,7 +17,11 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
+// Maximum number of queued packets written to the socket at once.
+constexpr size_t NETWORK_MAX_COALESCED_PACKETS = 256;
 
 NetworkConnection::NetworkConnection()
 {
@@ -74,7 +78,7 @@ int32_t NetworkConnection::ReadPacket()
         {
             _lastPacketTime = platform_get_ticks();
 
-            RecordPacketStats(InboundPacket, false);
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NETWORK_READPACKET_SUCCESS;
         }
@@ -82,62 +86,139 @@ int32_t NetworkConnection::ReadPacket()
     return NETWORK_READPACKET_MORE_DATA;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
 {
-    uint16_t sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8_t> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), (uint8_t*)&sizen, (uint8_t*)&sizen + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
+    packet->Size = (uint16_t)packet->Data->size();
+    QueuePacket(std::make_shared<const NetworkPacketPayload>(*packet), front);
+}
 
-    const void* buffer = &tosend[packet.BytesTransferred];
-    size_t bufferSize = tosend.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer, bufferSize);
-    if (sent > 0)
+void NetworkConnection::QueuePacket(const NetworkPacketPayloadPtr& payload, bool front)
+{
+    if (AuthStatus == NETWORK_AUTH_OK || !NetworkPacket::CommandRequiresAuth(payload->GetCommand()))
     {
-        packet.BytesTransferred += sent;
+        int32_t command = payload->GetCommand();
+        if (_holdPackets && !front && command != NETWORK_COMMAND_MAP && command != NETWORK_COMMAND_OBJECT_DATA)
+        {
+            // The map for this connection is still being prepared, anything queued after it
+            // was captured has to reach the client after the map and the objects it needs.
+            _heldPackets.push_back(payload);
+        }
+        else if (UsesIoThread)
+        {
+            // The outbound queue belongs to the I/O thread, it picks this up on the next flush.
+            _queuedPackets++;
+            _pendingPackets.Push({ payload, front });
+        }
+        else
+        {
+            _queuedPackets++;
+            AddOutboundPacket(payload, front);
+        }
     }
+}
 
-    bool sendComplete = packet.BytesTransferred == tosend.size();
-    if (sendComplete)
+void NetworkConnection::AddOutboundPacket(const NetworkPacketPayloadPtr& payload, bool front)
+{
+    if (front)
     {
-        RecordPacketStats(packet, true);
+        // If the first packet was already partially sent add new packet to second position
+        if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
+        {
+            OutboundPacket partial = std::move(_outboundPackets.front());
+            _outboundPackets.pop_front();
+            _outboundPackets.push_front({ payload, 0 });
+            _outboundPackets.push_front(std::move(partial));
+        }
+        else
+        {
+            _outboundPackets.push_front({ payload, 0 });
+        }
+    }
+    else
+    {
+        _outboundPackets.push_back({ payload, 0 });
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
+void NetworkConnection::SendQueuedPackets()
 {
-    if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
+    PendingPacket pending;
+    while (_pendingPackets.TryPop(pending))
     {
-        packet->Size = (uint16_t)packet->Data->size();
-        if (front)
+        AddOutboundPacket(pending.Payload, pending.Front);
+    }
+
+    while (!_outboundPackets.empty())
+    {
+        // Write as many queued packets as possible with a single vectored send, the first one may have been
+        // partially sent by the previous flush.
+        size_t numPackets = std::min(_outboundPackets.size(), NETWORK_MAX_COALESCED_PACKETS);
+        size_t bufferSize = 0;
+        _sendBuffers.clear();
+        for (size_t i = 0; i < numPackets; i++)
         {
-            // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
-            {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
-            }
-            else
+            const OutboundPacket& packet = _outboundPackets[i];
+            const NetworkPacketPayload& payload = *packet.Payload;
+            SocketBuffer buffer;
+            buffer.Data = payload.GetData() + packet.BytesTransferred;
+            buffer.Size = payload.GetLength() - packet.BytesTransferred;
+            _sendBuffers.push_back(buffer);
+            bufferSize += buffer.Size;
+        }
+
+        size_t sent = Socket->SendData(_sendBuffers.data(), _sendBuffers.size());
+        bool sendComplete = sent == bufferSize;
+
+        // Remove the packets that have been sent completely and remember how far the next one got.
+        while (sent > 0)
+        {
+            OutboundPacket& packet = _outboundPackets.front();
+            const NetworkPacketPayload& payload = *packet.Payload;
+            size_t remaining = payload.GetLength() - packet.BytesTransferred;
+            if (sent < remaining)
             {
-                _outboundPackets.push_front(std::move(packet));
+                packet.BytesTransferred += sent;
+                break;
             }
+
+            sent -= remaining;
+            RecordPacketStats(payload.GetCommand(), payload.GetLength(), true);
+            _outboundPackets.pop_front();
+            _queuedPackets--;
         }
-        else
+
+        if (!sendComplete)
         {
-            _outboundPackets.push_back(std::move(packet));
+            // Socket would block, try again next time.
+            break;
         }
     }
 }
 
-void NetworkConnection::SendQueuedPackets()
+void NetworkConnection::HoldPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(*_outboundPackets.front()))
+    _holdPackets = true;
+}
+
+void NetworkConnection::ReleasePackets()
+{
+    _holdPackets = false;
+    for (const auto& payload : _heldPackets)
     {
-        _outboundPackets.remove(_outboundPackets.front());
+        QueuePacket(payload);
     }
+    _heldPackets.clear();
+}
+
+void NetworkConnection::DiscardHeldPackets()
+{
+    _holdPackets = false;
+    _heldPackets.clear();
+}
+
+bool NetworkConnection::IsHoldingPackets() const
+{
+    return _holdPackets;
 }
 
 void NetworkConnection::ResetLastPacketTime()
@@ -145,6 +226,24 @@ void NetworkConnection::ResetLastPacketTime()
     _lastPacketTime = platform_get_ticks();
 }
 
+NetworkStats_t NetworkConnection::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    return _stats;
+}
+
+void NetworkConnection::RecordSendQueueDepth()
+{
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    _stats.sendQueueDepth.Add(_queuedPackets);
+}
+
+void NetworkConnection::RecordRoundTripTime(uint32_t time)
+{
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    _stats.roundTripTime.Add(time);
+}
+
 bool NetworkConnection::ReceivedPacketRecently()
 {
 #    ifndef DEBUG
@@ -184,31 +283,50 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(int32_t command, size_t size, bool sending)
 {
-    uint32_t packetSize = (uint32_t)packet.BytesTransferred;
+    uint32_t packetSize = (uint32_t)size;
     uint32_t trafficGroup = NETWORK_STATISTICS_GROUP_BASE;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NETWORK_COMMAND_GAMECMD:
         case NETWORK_COMMAND_GAME_ACTION:
+        case NETWORK_COMMAND_TICK_BATCH:
             trafficGroup = NETWORK_STATISTICS_GROUP_COMMANDS;
             break;
         case NETWORK_COMMAND_MAP:
+        case NETWORK_COMMAND_OBJECT_DATA:
             trafficGroup = NETWORK_STATISTICS_GROUP_MAPDATA;
             break;
     }
 
+    // Connections served by the network I/O thread record their stats from that thread.
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    NetworkCommandStats_t* commandStats = nullptr;
+    if (command >= 0 && command < NETWORK_COMMAND_MAX)
+    {
+        commandStats = &_stats.commands[command];
+    }
     if (sending)
     {
-        Stats.bytesSent[trafficGroup] += packetSize;
-        Stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL] += packetSize;
+        _stats.bytesSent[trafficGroup] += packetSize;
+        _stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL] += packetSize;
+        if (commandStats != nullptr)
+        {
+            commandStats->packetsSent++;
+            commandStats->bytesSent += packetSize;
+        }
     }
     else
     {
-        Stats.bytesReceived[trafficGroup] += packetSize;
-        Stats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL] += packetSize;
+        _stats.bytesReceived[trafficGroup] += packetSize;
+        _stats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL] += packetSize;
+        if (commandStats != nullptr)
+        {
+            commandStats->packetsReceived++;
+            commandStats->bytesReceived += packetSize;
+        }
     }
 }
 
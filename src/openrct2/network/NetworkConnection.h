@@ -11,17 +11,19 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../core/LockFreeQueue.h"
+#    include "../core/RingBuffer.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
-#    include <list>
+#    include <atomic>
 #    include <memory>
+#    include <mutex>
 #    include <vector>
 
 class NetworkPlayer;
-struct ObjectRepositoryItem;
 
 class NetworkConnection final
 {
@@ -29,34 +31,64 @@ public:
     std::unique_ptr<ITcpSocket> Socket = nullptr;
     NetworkPacket InboundPacket;
     NETWORK_AUTH AuthStatus = NETWORK_AUTH_NONE;
-    NetworkStats_t Stats = {};
     NetworkPlayer* Player = nullptr;
     uint32_t PingTime = 0;
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
-    std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool IsDisconnected = false;
+    // Set when the socket is read and written by the network I/O thread instead of the game thread.
+    bool UsesIoThread = false;
+    // Set for spectators of a relay once their map has been captured, from then on they receive the game of the server.
+    bool IsSpectating = false;
 
     NetworkConnection();
     ~NetworkConnection();
 
     int32_t ReadPacket();
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
+    void QueuePacket(const NetworkPacketPayloadPtr& payload, bool front = false);
     void SendQueuedPackets();
+    void HoldPackets();
+    void ReleasePackets();
+    void DiscardHeldPackets();
+    bool IsHoldingPackets() const;
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
+    NetworkStats_t GetStats() const;
+    void RecordSendQueueDepth();
+    void RecordRoundTripTime(uint32_t time);
 
     const utf8* GetLastDisconnectReason() const;
     void SetLastDisconnectReason(const utf8* src);
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::list<std::unique_ptr<NetworkPacket>> _outboundPackets;
-    uint32_t _lastPacketTime = 0;
+    struct OutboundPacket
+    {
+        NetworkPacketPayloadPtr Payload;
+        size_t BytesTransferred = 0;
+    };
+
+    struct PendingPacket
+    {
+        NetworkPacketPayloadPtr Payload;
+        bool Front = false;
+    };
+
+    RingBuffer<OutboundPacket> _outboundPackets;
+    LockFreeQueue<PendingPacket> _pendingPackets;
+    std::vector<NetworkPacketPayloadPtr> _heldPackets;
+    std::vector<SocketBuffer> _sendBuffers;
+    bool _holdPackets = false;
+    std::atomic<uint32_t> _lastPacketTime{ 0 };
+    // Packets queued but not sent completely yet, excluding held packets.
+    std::atomic<uint32_t> _queuedPackets{ 0 };
     utf8* _lastDisconnectReason = nullptr;
+    mutable std::mutex _statsMutex;
+    NetworkStats_t _stats = {};
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void AddOutboundPacket(const NetworkPacketPayloadPtr& payload, bool front);
+    void RecordPacketStats(int32_t command, size_t size, bool sending);
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,181 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkIoThread.h"
+
+#    include "../Diagnostic.h"
+
+#    include <algorithm>
+
+// Upper bound for how long the I/O thread sleeps, only matters for noticing it has to stop.
+constexpr int32_t NETWORK_IO_WAIT_TIMEOUT = 1000;
+constexpr size_t NETWORK_IO_MAX_EVENTS = 64;
+
+std::unique_ptr<NetworkIoThread> NetworkIoThread::Create(ITcpSocket& listenSocket)
+{
+    auto poller = CreateSocketPoller();
+    if (poller == nullptr)
+    {
+        return nullptr;
+    }
+    return std::make_unique<NetworkIoThread>(listenSocket, std::move(poller));
+}
+
+NetworkIoThread::NetworkIoThread(ITcpSocket& listenSocket, std::unique_ptr<ISocketPoller> poller)
+    : _listenSocket(listenSocket)
+    , _poller(std::move(poller))
+{
+    _poller->Add(_listenSocket, &_listenSocket);
+    _thread = std::thread(&NetworkIoThread::Run, this);
+}
+
+NetworkIoThread::~NetworkIoThread()
+{
+    _stop = true;
+    _poller->Wake();
+    _thread.join();
+}
+
+bool NetworkIoThread::PollEvent(NetworkIoEvent& e)
+{
+    return _events.TryPop(e);
+}
+
+void NetworkIoThread::Release(NetworkConnection& connection)
+{
+    _releases.Push(&connection);
+    _poller->Wake();
+}
+
+void NetworkIoThread::Flush()
+{
+    _poller->Wake();
+}
+
+void NetworkIoThread::Run()
+{
+    SocketPollEvent pollEvents[NETWORK_IO_MAX_EVENTS];
+    while (!_stop)
+    {
+        size_t numEvents = _poller->Wait(pollEvents, NETWORK_IO_MAX_EVENTS, NETWORK_IO_WAIT_TIMEOUT);
+
+        NetworkConnection* released;
+        while (_releases.TryPop(released))
+        {
+            RemoveConnection(*released);
+            PushEvent(NETWORK_IO_EVENT_RELEASED, *released);
+        }
+
+        for (size_t i = 0; i < numEvents; i++)
+        {
+            const auto& pollEvent = pollEvents[i];
+            if (pollEvent.UserData == &_listenSocket)
+            {
+                AcceptClients();
+                continue;
+            }
+
+            // The connection may have been removed since the event was reported.
+            auto connection = static_cast<NetworkConnection*>(pollEvent.UserData);
+            if (std::find(_connections.begin(), _connections.end(), connection) == _connections.end())
+            {
+                continue;
+            }
+
+            if (pollEvent.Readable)
+            {
+                ReadPackets(*connection);
+            }
+        }
+
+        // Write whatever the game thread queued, sockets that would block are retried once they become writable.
+        for (auto connection : _connections)
+        {
+            connection->SendQueuedPackets();
+        }
+    }
+
+    for (auto connection : _connections)
+    {
+        _poller->Remove(*connection->Socket);
+    }
+    _connections.clear();
+}
+
+void NetworkIoThread::AcceptClients()
+{
+    std::unique_ptr<ITcpSocket> tcpSocket;
+    while ((tcpSocket = _listenSocket.Accept()) != nullptr)
+    {
+        auto connection = std::make_unique<NetworkConnection>();
+        connection->Socket = std::move(tcpSocket);
+        connection->UsesIoThread = true;
+        try
+        {
+            _poller->Add(*connection->Socket, connection.get());
+        }
+        catch (const std::exception& ex)
+        {
+            log_error("Unable to accept client: %s", ex.what());
+            continue;
+        }
+        _connections.push_back(connection.get());
+
+        NetworkIoEvent e;
+        e.Type = NETWORK_IO_EVENT_ACCEPTED;
+        e.Connection = connection.get();
+        e.AcceptedConnection = std::move(connection);
+        _events.Push(std::move(e));
+    }
+}
+
+void NetworkIoThread::ReadPackets(NetworkConnection& connection)
+{
+    int32_t packetStatus;
+    do
+    {
+        packetStatus = connection.ReadPacket();
+        if (packetStatus == NETWORK_READPACKET_SUCCESS)
+        {
+            NetworkIoEvent e;
+            e.Type = NETWORK_IO_EVENT_PACKET;
+            e.Connection = &connection;
+            e.Packet = std::make_unique<NetworkPacket>(std::move(connection.InboundPacket));
+            _events.Push(std::move(e));
+            connection.InboundPacket = NetworkPacket();
+        }
+        else if (packetStatus == NETWORK_READPACKET_DISCONNECTED)
+        {
+            RemoveConnection(connection);
+            PushEvent(NETWORK_IO_EVENT_DISCONNECTED, connection);
+        }
+    } while (packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS);
+}
+
+void NetworkIoThread::RemoveConnection(NetworkConnection& connection)
+{
+    auto it = std::find(_connections.begin(), _connections.end(), &connection);
+    if (it != _connections.end())
+    {
+        _poller->Remove(*connection.Socket);
+        _connections.erase(it);
+    }
+}
+
+void NetworkIoThread::PushEvent(NETWORK_IO_EVENT type, NetworkConnection& connection)
+{
+    NetworkIoEvent e;
+    e.Type = type;
+    e.Connection = &connection;
+    _events.Push(std::move(e));
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+#    include "../common.h"
+#    include "../core/LockFreeQueue.h"
+#    include "NetworkConnection.h"
+#    include "NetworkPacket.h"
+#    include "Socket.h"
+
+#    include <atomic>
+#    include <memory>
+#    include <thread>
+#    include <vector>
+
+enum NETWORK_IO_EVENT
+{
+    NETWORK_IO_EVENT_NONE,
+    NETWORK_IO_EVENT_ACCEPTED,
+    NETWORK_IO_EVENT_PACKET,
+    NETWORK_IO_EVENT_DISCONNECTED,
+    NETWORK_IO_EVENT_RELEASED,
+};
+
+struct NetworkIoEvent
+{
+    NETWORK_IO_EVENT Type = NETWORK_IO_EVENT_NONE;
+    NetworkConnection* Connection = nullptr;
+    // Ownership of the connection passes to the game thread with NETWORK_IO_EVENT_ACCEPTED.
+    std::unique_ptr<NetworkConnection> AcceptedConnection;
+    std::unique_ptr<NetworkPacket> Packet;
+};
+
+/**
+ * Accepts, reads and writes all client connections of the server on a dedicated thread which only wakes up when a
+ * socket is ready. Complete packets and connection changes are handed to the game thread as events, so neither the
+ * frame rate nor the number of clients affects how quickly the server responds.
+ *
+ * A connection keeps being used by the I/O thread until the game thread has released it and received
+ * NETWORK_IO_EVENT_RELEASED for it, only then it can be destroyed.
+ */
+class NetworkIoThread final
+{
+public:
+    /**
+     * Returns nullptr if sockets can not be polled on this platform.
+     */
+    static std::unique_ptr<NetworkIoThread> Create(ITcpSocket& listenSocket);
+
+    NetworkIoThread(ITcpSocket& listenSocket, std::unique_ptr<ISocketPoller> poller);
+    ~NetworkIoThread();
+
+    bool PollEvent(NetworkIoEvent& e);
+    void Release(NetworkConnection& connection);
+    void Flush();
+
+private:
+    ITcpSocket& _listenSocket;
+    std::unique_ptr<ISocketPoller> _poller;
+    std::atomic<bool> _stop{ false };
+    LockFreeQueue<NetworkIoEvent> _events;
+    LockFreeQueue<NetworkConnection*> _releases;
+    // Only used by the I/O thread.
+    std::vector<NetworkConnection*> _connections;
+    std::thread _thread;
+
+    void Run();
+    void AcceptClients();
+    void ReadPackets(NetworkConnection& connection);
+    void RemoveConnection(NetworkConnection& connection);
+    void PushEvent(NETWORK_IO_EVENT type, NetworkConnection& connection);
+};
+
+#endif // DISABLE_NETWORK
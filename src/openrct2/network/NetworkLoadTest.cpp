@@ -0,0 +1,547 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkLoadTest.h"
+
+#    include "../actions/GameAction.h"
+#    include "../actions/ParkSetResearchFundingAction.hpp"
+#    include "../actions/SmallSceneryPlaceAction.hpp"
+#    include "../actions/SmallSceneryRemoveAction.hpp"
+#    include "../management/Research.h"
+#    include "../platform/platform.h"
+#    include "NetworkConnection.h"
+#    include "NetworkKey.h"
+#    include "NetworkPacket.h"
+#    include "NetworkTickBatch.h"
+#    include "network.h"
+
+#    include <algorithm>
+#    include <chrono>
+#    include <cstdlib>
+#    include <cstring>
+#    include <map>
+
+// Pending actions and chat messages older than this are assumed to have been rejected by the server.
+constexpr uint32_t NETWORK_LOADTEST_PENDING_TIMEOUT = 30000;
+
+enum NETWORK_LOADTEST_CLIENT_STATE
+{
+    NETWORK_LOADTEST_CLIENT_STATE_NONE,
+    NETWORK_LOADTEST_CLIENT_STATE_CONNECTING,
+    NETWORK_LOADTEST_CLIENT_STATE_AUTHENTICATING,
+    NETWORK_LOADTEST_CLIENT_STATE_DOWNLOADING,
+    NETWORK_LOADTEST_CLIENT_STATE_JOINED,
+    NETWORK_LOADTEST_CLIENT_STATE_FAILED,
+};
+
+class NetworkLoadTest::Client final
+{
+public:
+    NetworkLoadTestClientResult Result;
+
+    Client(size_t index, size_t numClients, const std::string& host, uint16_t port, const NetworkLoadTestWorkload& workload)
+        : _index(index)
+        , _host(host)
+        , _port(port)
+        , _workload(workload)
+    {
+        Result.Name = "loadtest" + std::to_string(index + 1);
+        _chatMarker = "[" + Result.Name + "#";
+
+        // Every client gets its own tiles so they do not get in each others way.
+        for (size_t i = index; i < workload.SceneryTiles.size(); i += numClients)
+        {
+            _tiles.push_back(workload.SceneryTiles[i]);
+        }
+    }
+
+    NETWORK_LOADTEST_CLIENT_STATE GetState() const
+    {
+        return _state;
+    }
+
+    bool GenerateKey()
+    {
+        if (!_key.Generate())
+        {
+            Fail("Unable to generate key.");
+            return false;
+        }
+        return true;
+    }
+
+    void Connect(uint32_t now)
+    {
+        try
+        {
+            _connection.Socket = CreateTcpSocket();
+            _connection.Socket->ConnectAsync(_host, _port);
+            _connectTime = now;
+            _state = NETWORK_LOADTEST_CLIENT_STATE_CONNECTING;
+        }
+        catch (const std::exception& ex)
+        {
+            Fail(ex.what());
+        }
+    }
+
+    void Update(uint32_t now)
+    {
+        if (_state == NETWORK_LOADTEST_CLIENT_STATE_CONNECTING)
+        {
+            switch (_connection.Socket->GetStatus())
+            {
+                case SOCKET_STATUS_CONNECTED:
+                {
+                    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+                    *packet << (uint32_t)NETWORK_COMMAND_TOKEN;
+                    _connection.QueuePacket(std::move(packet));
+                    _state = NETWORK_LOADTEST_CLIENT_STATE_AUTHENTICATING;
+                    break;
+                }
+                case SOCKET_STATUS_CLOSED:
+                {
+                    const char* error = _connection.Socket->GetError();
+                    Fail(error != nullptr ? error : "Unable to connect.");
+                    return;
+                }
+                default:
+                    return;
+            }
+        }
+        else if (_state == NETWORK_LOADTEST_CLIENT_STATE_NONE || _state == NETWORK_LOADTEST_CLIENT_STATE_FAILED)
+        {
+            return;
+        }
+
+        int32_t packetStatus;
+        do
+        {
+            packetStatus = _connection.ReadPacket();
+            if (packetStatus == NETWORK_READPACKET_SUCCESS)
+            {
+                HandlePacket(_connection.InboundPacket, now);
+                _connection.InboundPacket.Clear();
+            }
+            else if (packetStatus == NETWORK_READPACKET_DISCONNECTED)
+            {
+                Fail("Disconnected by server.");
+                return;
+            }
+        } while (_state != NETWORK_LOADTEST_CLIENT_STATE_FAILED
+                 && (packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS));
+
+        if (_state == NETWORK_LOADTEST_CLIENT_STATE_JOINED)
+        {
+            if (now - _lastActionTime >= _workload.ActionInterval)
+            {
+                SendNextAction(now);
+            }
+            if (_workload.ChatInterval != 0 && now - _lastChatTime >= _workload.ChatInterval)
+            {
+                SendChat(now);
+            }
+            ExpirePending(now);
+        }
+        _connection.SendQueuedPackets();
+    }
+
+    void BeginMeasuring()
+    {
+        _measureStartStats = _connection.GetStats();
+    }
+
+    void Finish()
+    {
+        Result.Stats = _connection.GetStats();
+        Result.MeasuredBytesReceived = Result.Stats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL]
+            - _measureStartStats.bytesReceived[NETWORK_STATISTICS_GROUP_TOTAL];
+        Result.MeasuredBytesSent = Result.Stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL]
+            - _measureStartStats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL];
+        if (_connection.Socket != nullptr)
+        {
+            _connection.Socket->Disconnect();
+        }
+    }
+
+private:
+    size_t _index;
+    std::string _host;
+    uint16_t _port;
+    const NetworkLoadTestWorkload& _workload;
+    NETWORK_LOADTEST_CLIENT_STATE _state = NETWORK_LOADTEST_CLIENT_STATE_NONE;
+    NetworkConnection _connection;
+    NetworkStats_t _measureStartStats = {};
+    NetworkKey _key;
+    uint8_t _playerId = 0;
+    uint32_t _serverTick = 0;
+    uint32_t _connectTime = 0;
+    uint32_t _lastActionTime = 0;
+    uint32_t _lastChatTime = 0;
+    uint32_t _actionId = 0;
+    uint32_t _chatId = 0;
+    uint32_t _numActions = 0;
+    std::string _chatMarker;
+    std::vector<NetworkLoadTestTile> _tiles;
+    size_t _tileIndex = 0;
+    // Network id or chat id -> time it was sent.
+    std::map<uint32_t, uint32_t> _pendingActions;
+    std::map<uint32_t, uint32_t> _pendingChats;
+
+    void Fail(const std::string& error)
+    {
+        _state = NETWORK_LOADTEST_CLIENT_STATE_FAILED;
+        Result.Error = error;
+    }
+
+    void HandlePacket(NetworkPacket& packet, uint32_t now)
+    {
+        uint32_t command;
+        packet >> command;
+        switch (command)
+        {
+            case NETWORK_COMMAND_TOKEN:
+                HandleToken(packet);
+                break;
+            case NETWORK_COMMAND_AUTH:
+                HandleAuth(packet);
+                break;
+            case NETWORK_COMMAND_OBJECTS:
+            {
+                // The clients share the object repository of the server, so they never request any objects.
+                std::unique_ptr<NetworkPacket> reply(NetworkPacket::Allocate());
+                *reply << (uint32_t)NETWORK_COMMAND_OBJECTS << (uint32_t)0;
+                _connection.QueuePacket(std::move(reply));
+                _state = NETWORK_LOADTEST_CLIENT_STATE_DOWNLOADING;
+                break;
+            }
+            case NETWORK_COMMAND_MAP:
+                HandleMap(packet, now);
+                break;
+            case NETWORK_COMMAND_TICK:
+                packet >> _serverTick;
+                break;
+            case NETWORK_COMMAND_PING:
+            {
+                std::unique_ptr<NetworkPacket> reply(NetworkPacket::Allocate());
+                *reply << (uint32_t)NETWORK_COMMAND_PING;
+                _connection.QueuePacket(std::move(reply));
+                break;
+            }
+            case NETWORK_COMMAND_TICK_BATCH:
+                HandleTickBatch(packet, now);
+                break;
+            case NETWORK_COMMAND_GAME_ACTION:
+            {
+                uint32_t tick, actionType;
+                packet >> tick >> actionType;
+                size_t size = packet.Size - packet.BytesRead;
+                HandleGameAction(actionType, packet.Read(size), size, now);
+                break;
+            }
+            case NETWORK_COMMAND_CHAT:
+                HandleChat(packet, now);
+                break;
+            case NETWORK_COMMAND_SETDISCONNECTMSG:
+            {
+                const char* message = packet.ReadString();
+                Fail(message != nullptr ? message : "Disconnected by server.");
+                break;
+            }
+        }
+    }
+
+    void HandleToken(NetworkPacket& packet)
+    {
+        uint32_t challengeSize;
+        packet >> challengeSize;
+        const uint8_t* challenge = packet.Read(challengeSize);
+        std::vector<uint8_t> signature;
+        if (challenge == nullptr || !_key.Sign(challenge, challengeSize, signature))
+        {
+            Fail("Unable to sign the server's challenge.");
+            return;
+        }
+
+        std::unique_ptr<NetworkPacket> reply(NetworkPacket::Allocate());
+        *reply << (uint32_t)NETWORK_COMMAND_AUTH;
+        reply->WriteString(network_get_version().c_str());
+        reply->WriteString(Result.Name.c_str());
+        reply->WriteString("");
+        reply->WriteString(_key.PublicKeyString().c_str());
+        *reply << (uint32_t)signature.size();
+        reply->Write(signature.data(), signature.size());
+        _connection.QueuePacket(std::move(reply));
+    }
+
+    void HandleAuth(NetworkPacket& packet)
+    {
+        uint32_t authStatus;
+        packet >> authStatus >> _playerId;
+        if (authStatus != NETWORK_AUTH_OK)
+        {
+            Fail("Authentication failed with status " + std::to_string(authStatus) + ".");
+            return;
+        }
+
+        std::unique_ptr<NetworkPacket> reply(NetworkPacket::Allocate());
+        *reply << (uint32_t)NETWORK_COMMAND_GAMEINFO;
+        _connection.QueuePacket(std::move(reply));
+    }
+
+    void HandleMap(NetworkPacket& packet, uint32_t now)
+    {
+        uint32_t size, offset;
+        packet >> size >> offset;
+        size_t chunkSize = packet.Size - packet.BytesRead;
+        if (offset + chunkSize >= size && _state != NETWORK_LOADTEST_CLIENT_STATE_JOINED)
+        {
+            _state = NETWORK_LOADTEST_CLIENT_STATE_JOINED;
+            Result.Joined = true;
+            Result.JoinTime = now - _connectTime;
+
+            // Spread the actions of all clients evenly instead of sending them in bursts.
+            _lastActionTime = now - (uint32_t)(_index * 7919 % std::max<uint32_t>(_workload.ActionInterval, 1));
+            _lastChatTime = now - (uint32_t)(_index * 7919 % std::max<uint32_t>(_workload.ChatInterval, 1));
+        }
+    }
+
+    void HandleTickBatch(NetworkPacket& packet, uint32_t now)
+    {
+        NetworkTickBatch batch;
+        if (!batch.Read(packet))
+        {
+            Fail("Received a malformed tick batch.");
+            return;
+        }
+
+        _serverTick = batch.Tick;
+        for (size_t i = 0; i < batch.GetNumActions(); i++)
+        {
+            auto action = batch.GetAction(i);
+            HandleGameAction(action.Type, action.Data, action.Size, now);
+        }
+    }
+
+    void HandleGameAction(uint32_t actionType, const uint8_t* data, size_t size, uint32_t now)
+    {
+        GameAction::Ptr action = GameActions::Create(actionType);
+        if (action == nullptr)
+        {
+            return;
+        }
+
+        DataSerialiser stream(false);
+        stream.GetStream().WriteArray(data, size);
+        stream.GetStream().SetPosition(0);
+        action->Serialise(stream);
+        if (action->GetPlayer().id != _playerId)
+        {
+            return;
+        }
+
+        auto it = _pendingActions.find(action->GetNetworkId());
+        if (it != _pendingActions.end())
+        {
+            Result.ActionsConfirmed++;
+            Result.Latencies.push_back(now - it->second);
+            _pendingActions.erase(it);
+        }
+    }
+
+    void HandleChat(NetworkPacket& packet, uint32_t now)
+    {
+        const char* text = packet.ReadString();
+        if (text == nullptr)
+        {
+            return;
+        }
+
+        const char* marker = strstr(text, _chatMarker.c_str());
+        if (marker != nullptr)
+        {
+            uint32_t chatId = (uint32_t)atol(marker + _chatMarker.size());
+            auto it = _pendingChats.find(chatId);
+            if (it != _pendingChats.end())
+            {
+                Result.ChatsConfirmed++;
+                Result.Latencies.push_back(now - it->second);
+                _pendingChats.erase(it);
+            }
+        }
+    }
+
+    GameAction::Ptr CreateNextAction()
+    {
+        // Place a piece of scenery, change the research funding and remove the scenery again.
+        uint32_t step = _numActions++ % 3;
+        if (_workload.SceneryType != 0xFF && !_tiles.empty())
+        {
+            const auto& tile = _tiles[_tileIndex];
+            if (step == 0)
+            {
+                CoordsXYZD loc = { tile.X, tile.Y, tile.BaseHeight * 8, 0 };
+                return std::make_unique<SmallSceneryPlaceAction>(loc, 0, _workload.SceneryType, 0, 0);
+            }
+            if (step == 2)
+            {
+                _tileIndex = (_tileIndex + 1) % _tiles.size();
+                return std::make_unique<SmallSceneryRemoveAction>(tile.X, tile.Y, tile.BaseHeight, 0, _workload.SceneryType);
+            }
+        }
+        uint8_t priorities = (1 << (RESEARCH_CATEGORY_SCENERY_GROUP + 1)) - 1;
+        return std::make_unique<ParkSetResearchFundingAction>(priorities, _numActions % RESEARCH_FUNDING_COUNT);
+    }
+
+    void SendNextAction(uint32_t now)
+    {
+        GameAction::Ptr action = CreateNextAction();
+        uint32_t networkId = ++_actionId;
+        action->SetNetworkId(networkId);
+
+        DataSerialiser stream(true);
+        action->Serialise(stream);
+
+        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+        *packet << (uint32_t)NETWORK_COMMAND_GAME_ACTION << _serverTick << action->GetType() << stream;
+        _connection.QueuePacket(std::move(packet));
+
+        _pendingActions[networkId] = now;
+        _lastActionTime = now;
+        Result.ActionsSent++;
+    }
+
+    void SendChat(uint32_t now)
+    {
+        uint32_t chatId = ++_chatId;
+        std::string text = "Load test message " + _chatMarker + std::to_string(chatId) + "]";
+
+        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+        *packet << (uint32_t)NETWORK_COMMAND_CHAT;
+        packet->WriteString(text.c_str());
+        _connection.QueuePacket(std::move(packet));
+
+        _pendingChats[chatId] = now;
+        _lastChatTime = now;
+        Result.ChatsSent++;
+    }
+
+    void ExpirePending(uint32_t now)
+    {
+        for (auto pending : { &_pendingActions, &_pendingChats })
+        {
+            // Ids are handed out in order, so the oldest entry is always the first one.
+            while (!pending->empty() && now - pending->begin()->second > NETWORK_LOADTEST_PENDING_TIMEOUT)
+            {
+                pending->erase(pending->begin());
+            }
+        }
+    }
+};
+
+NetworkLoadTest::NetworkLoadTest(
+    const std::string& host, uint16_t port, size_t numClients, const NetworkLoadTestWorkload& workload)
+    : _workload(workload)
+{
+    for (size_t i = 0; i < numClients; i++)
+    {
+        _clients.push_back(std::make_unique<Client>(i, numClients, host, port, _workload));
+    }
+    _thread = std::thread(&NetworkLoadTest::Run, this);
+}
+
+NetworkLoadTest::~NetworkLoadTest()
+{
+    if (_thread.joinable())
+    {
+        Stop();
+    }
+}
+
+size_t NetworkLoadTest::GetNumJoined() const
+{
+    return _numJoined;
+}
+
+size_t NetworkLoadTest::GetNumFailed() const
+{
+    return _numFailed;
+}
+
+void NetworkLoadTest::BeginMeasuring()
+{
+    _measuring = true;
+}
+
+std::vector<NetworkLoadTestClientResult> NetworkLoadTest::Stop()
+{
+    _stop = true;
+    _thread.join();
+
+    std::vector<NetworkLoadTestClientResult> results;
+    for (auto& client : _clients)
+    {
+        client->Finish();
+        results.push_back(std::move(client->Result));
+    }
+    _clients.clear();
+    return results;
+}
+
+void NetworkLoadTest::Run()
+{
+    // Generating the keys takes a while, so do it before connecting to not skew the join times.
+    for (auto& client : _clients)
+    {
+        if (_stop)
+        {
+            return;
+        }
+        if (!client->GenerateKey())
+        {
+            _numFailed++;
+        }
+    }
+
+    uint32_t now = platform_get_ticks();
+    for (auto& client : _clients)
+    {
+        if (client->GetState() == NETWORK_LOADTEST_CLIENT_STATE_NONE)
+        {
+            client->Connect(now);
+        }
+    }
+
+    bool measuring = false;
+    while (!_stop)
+    {
+        size_t numJoined = 0;
+        size_t numFailed = 0;
+        now = platform_get_ticks();
+        bool beginMeasuring = !measuring && _measuring;
+        measuring = measuring || beginMeasuring;
+        for (auto& client : _clients)
+        {
+            if (beginMeasuring)
+            {
+                client->BeginMeasuring();
+            }
+            client->Update(now);
+            numJoined += client->GetState() == NETWORK_LOADTEST_CLIENT_STATE_JOINED ? 1 : 0;
+            numFailed += client->GetState() == NETWORK_LOADTEST_CLIENT_STATE_FAILED ? 1 : 0;
+        }
+        _numJoined = numJoined;
+        _numFailed = numFailed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+#    include "../common.h"
+#    include "NetworkTypes.h"
+
+#    include <atomic>
+#    include <memory>
+#    include <string>
+#    include <thread>
+#    include <vector>
+
+struct NetworkLoadTestTile
+{
+    int16_t X;
+    int16_t Y;
+    uint8_t BaseHeight;
+};
+
+/**
+ * Describes what the synthetic clients do once they have joined.
+ */
+struct NetworkLoadTestWorkload
+{
+    // Free tiles the clients may place and remove scenery on, they are shared out between the clients.
+    std::vector<NetworkLoadTestTile> SceneryTiles;
+    uint8_t SceneryType = 0xFF;
+    // Milliseconds between two game actions of the same client.
+    uint32_t ActionInterval = 1000;
+    // Milliseconds between two chat messages of the same client, 0 disables chat.
+    uint32_t ChatInterval = 10000;
+};
+
+struct NetworkLoadTestClientResult
+{
+    std::string Name;
+    bool Joined = false;
+    // Milliseconds from connecting until the whole map was received.
+    uint32_t JoinTime = 0;
+    uint32_t ActionsSent = 0;
+    uint32_t ActionsConfirmed = 0;
+    uint32_t ChatsSent = 0;
+    uint32_t ChatsConfirmed = 0;
+    // Milliseconds until the server broadcast each confirmed game action or chat message.
+    std::vector<uint32_t> Latencies;
+    NetworkStats_t Stats = {};
+    // Bytes transferred after BeginMeasuring, without the map download and any other joining traffic.
+    uint64_t MeasuredBytesReceived = 0;
+    uint64_t MeasuredBytesSent = 0;
+    std::string Error;
+};
+
+/**
+ * Runs a number of synthetic multiplayer clients on a single background thread. The clients speak the regular
+ * protocol, they authenticate with a throwaway key, download the map and then keep sending game actions and chat
+ * messages while measuring how long the server takes to broadcast them back.
+ */
+class NetworkLoadTest final
+{
+public:
+    NetworkLoadTest(const std::string& host, uint16_t port, size_t numClients, const NetworkLoadTestWorkload& workload);
+    ~NetworkLoadTest();
+
+    size_t GetNumJoined() const;
+    size_t GetNumFailed() const;
+    void BeginMeasuring();
+    std::vector<NetworkLoadTestClientResult> Stop();
+
+private:
+    class Client;
+
+    std::vector<std::unique_ptr<Client>> _clients;
+    NetworkLoadTestWorkload _workload;
+    std::atomic<bool> _stop{ false };
+    std::atomic<bool> _measuring{ false };
+    std::atomic<size_t> _numJoined{ 0 };
+    std::atomic<size_t> _numFailed{ 0 };
+    std::thread _thread;
+
+    void Run();
+};
+
+#endif // DISABLE_NETWORK
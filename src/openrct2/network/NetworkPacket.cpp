@@ -12,6 +12,7 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
 #    include <memory>
 
@@ -20,9 +21,19 @@ std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
     return std::make_unique<NetworkPacket>();
 }
 
-std::unique_ptr<NetworkPacket> NetworkPacket::Duplicate(NetworkPacket& packet)
+bool NetworkPacket::CommandRequiresAuth(int32_t command)
 {
-    return std::make_unique<NetworkPacket>(packet);
+    switch (command)
+    {
+        case NETWORK_COMMAND_PING:
+        case NETWORK_COMMAND_AUTH:
+        case NETWORK_COMMAND_TOKEN:
+        case NETWORK_COMMAND_GAMEINFO:
+        case NETWORK_COMMAND_OBJECTS:
+            return false;
+        default:
+            return true;
+    }
 }
 
 uint8_t* NetworkPacket::GetData()
@@ -51,17 +62,7 @@ void NetworkPacket::Clear()
 
 bool NetworkPacket::CommandRequiresAuth()
 {
-    switch (GetCommand())
-    {
-        case NETWORK_COMMAND_PING:
-        case NETWORK_COMMAND_AUTH:
-        case NETWORK_COMMAND_TOKEN:
-        case NETWORK_COMMAND_GAMEINFO:
-        case NETWORK_COMMAND_OBJECTS:
-            return false;
-        default:
-            return true;
-    }
+    return CommandRequiresAuth(GetCommand());
 }
 
 void NetworkPacket::Write(const uint8_t* bytes, size_t size)
@@ -105,4 +106,13 @@ const utf8* NetworkPacket::ReadString()
     return str;
 }
 
+NetworkPacketPayload::NetworkPacketPayload(const NetworkPacket& packet)
+    : _command(packet.GetCommand())
+{
+    uint16_t sizen = Convert::HostToNetwork((uint16_t)packet.Data->size());
+    _data.reserve(sizeof(sizen) + packet.Data->size());
+    _data.insert(_data.end(), (uint8_t*)&sizen, (uint8_t*)&sizen + sizeof(sizen));
+    _data.insert(_data.end(), packet.Data->begin(), packet.Data->end());
+}
+
 #endif
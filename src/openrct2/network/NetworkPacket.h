@@ -25,7 +25,7 @@ public:
     size_t BytesRead = 0;
 
     static std::unique_ptr<NetworkPacket> Allocate();
-    static std::unique_ptr<NetworkPacket> Duplicate(NetworkPacket& packet);
+    static bool CommandRequiresAuth(int32_t command);
 
     uint8_t* GetData();
     int32_t GetCommand() const;
@@ -69,3 +69,34 @@ public:
         return *this;
     }
 };
+
+/**
+ * A packet serialised as it is sent over the wire, including the size prefix. It is never modified once created so the
+ * same payload can be queued on any number of connections without copying it.
+ */
+class NetworkPacketPayload final
+{
+public:
+    explicit NetworkPacketPayload(const NetworkPacket& packet);
+
+    int32_t GetCommand() const
+    {
+        return _command;
+    }
+
+    const uint8_t* GetData() const
+    {
+        return _data.data();
+    }
+
+    size_t GetLength() const
+    {
+        return _data.size();
+    }
+
+private:
+    int32_t _command;
+    std::vector<uint8_t> _data;
+};
+
+using NetworkPacketPayloadPtr = std::shared_ptr<const NetworkPacketPayload>;
@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkRelayQueue.h"
+
+#    include "NetworkTypes.h"
+
+#    include <cstring>
+
+bool NetworkRelayQueue::Push(const NetworkPacket& packet)
+{
+    NetworkRelayPacket relayPacket;
+    switch (packet.GetCommand())
+    {
+        case NETWORK_COMMAND_TICK:
+        case NETWORK_COMMAND_TICK_BATCH:
+        case NETWORK_COMMAND_GAME_ACTION:
+        case NETWORK_COMMAND_GAMECMD:
+        case NETWORK_COMMAND_PLAYERLIST:
+        case NETWORK_COMMAND_PLAYERINFO:
+        {
+            // The server writes the tick directly after the command in all of these.
+            if (packet.Data->size() < 2 * sizeof(uint32_t))
+            {
+                return false;
+            }
+            uint32_t tick;
+            std::memcpy(&tick, packet.Data->data() + sizeof(uint32_t), sizeof(tick));
+            relayPacket.Timed = true;
+            relayPacket.Tick = ByteSwapBE(tick);
+            break;
+        }
+        case NETWORK_COMMAND_CHAT:
+        case NETWORK_COMMAND_PINGLIST:
+        case NETWORK_COMMAND_GROUPLIST:
+        case NETWORK_COMMAND_EVENT:
+            break;
+        default:
+            return false;
+    }
+    relayPacket.Payload = std::make_shared<const NetworkPacketPayload>(packet);
+    _packets.push_back(std::move(relayPacket));
+    return true;
+}
+
+bool NetworkRelayQueue::Pop(uint32_t currentTick, NetworkRelayPacket& relayPacket)
+{
+    if (_packets.empty())
+    {
+        return false;
+    }
+
+    const auto& front = _packets.front();
+    if (front.Timed && front.Tick > currentTick)
+    {
+        return false;
+    }
+    relayPacket = std::move(_packets.front());
+    _packets.pop_front();
+    return true;
+}
+
+void NetworkRelayQueue::Clear()
+{
+    _packets.clear();
+}
+
+size_t NetworkRelayQueue::GetCount() const
+{
+    return _packets.size();
+}
+
+#endif
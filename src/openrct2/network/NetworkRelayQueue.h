@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+#    include "../common.h"
+#    include "NetworkPacket.h"
+
+#    include <deque>
+
+// Packet of the server a relay passes on to its spectators.
+struct NetworkRelayPacket
+{
+    // Set for packets that belong to a tick, these are held back until the relay has run that tick itself.
+    bool Timed = false;
+    uint32_t Tick = 0;
+    NetworkPacketPayloadPtr Payload;
+};
+
+/**
+ * The packets a relay received from the server and still has to pass on to its spectators. Spectators start from the
+ * map of the relay, so they may only receive ticks the relay has already run itself, everything older is part of the map
+ * they receive.
+ */
+class NetworkRelayQueue final
+{
+public:
+    /**
+     * Queues a packet received from the server, returns false if it only concerns the connection between the relay and
+     * the server or is malformed.
+     */
+    bool Push(const NetworkPacket& packet);
+
+    /**
+     * Removes the next packet that may be passed on once the relay has run the given tick, returns false if there is
+     * none.
+     */
+    bool Pop(uint32_t currentTick, NetworkRelayPacket& relayPacket);
+
+    void Clear();
+    size_t GetCount() const;
+
+private:
+    std::deque<NetworkRelayPacket> _packets;
+};
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkResyncHistory.h"
+
+#    include "NetworkTypes.h"
+
+#    include <algorithm>
+
+NetworkResyncHistory::NetworkResyncHistory(uint32_t maxTicks, size_t maxSize)
+    : _maxTicks(maxTicks)
+    , _maxSize(maxSize)
+{
+}
+
+void NetworkResyncHistory::Push(uint32_t tick, const NetworkPacketPayloadPtr& payload)
+{
+    _packets.push_back({ tick, payload });
+    _size += payload->GetLength();
+    _sequence++;
+    while (!_packets.empty() && (_size > _maxSize || _packets.front().Tick + _maxTicks < tick))
+    {
+        // More packets of the same tick may follow, only the next tick is still complete.
+        _firstTick = std::max(_firstTick, _packets.front().Tick + 1);
+        _size -= _packets.front().Payload->GetLength();
+        _packets.pop_front();
+    }
+    _hashes.erase(_hashes.begin(), _hashes.lower_bound(_firstTick));
+}
+
+void NetworkResyncHistory::Reset(uint32_t tick)
+{
+    _packets.clear();
+    _size = 0;
+    // Leave a gap in the sequence so nothing captured before is continued.
+    _sequence++;
+    _firstTick = tick;
+    _hashes.clear();
+}
+
+uint32_t NetworkResyncHistory::GetFirstTick() const
+{
+    return _firstTick;
+}
+
+uint64_t NetworkResyncHistory::GetSequence() const
+{
+    return _sequence;
+}
+
+size_t NetworkResyncHistory::GetCount() const
+{
+    return _packets.size();
+}
+
+size_t NetworkResyncHistory::GetSize() const
+{
+    return _size;
+}
+
+bool NetworkResyncHistory::Contains(uint64_t sequence) const
+{
+    return sequence <= _sequence && sequence + _packets.size() >= _sequence;
+}
+
+std::vector<NetworkPacketPayloadPtr> NetworkResyncHistory::GetPacketsSince(uint64_t sequence) const
+{
+    std::vector<NetworkPacketPayloadPtr> packets;
+    if (Contains(sequence))
+    {
+        auto it = _packets.end() - (size_t)(_sequence - sequence);
+        for (; it != _packets.end(); it++)
+        {
+            packets.push_back(it->Payload);
+        }
+    }
+    return packets;
+}
+
+bool NetworkResyncHistory::GetPacketsFrom(
+    uint32_t tick, uint32_t skipCommands, std::vector<NetworkPacketPayloadPtr>& packets) const
+{
+    if (tick < _firstTick)
+    {
+        return false;
+    }
+
+    auto it = std::find_if(_packets.begin(), _packets.end(), [tick](const HistoryPacket& entry) { return entry.Tick >= tick; });
+    for (; it != _packets.end(); it++)
+    {
+        if (skipCommands != 0 && it->Tick == tick)
+        {
+            switch (it->Payload->GetCommand())
+            {
+                case NETWORK_COMMAND_GAME_ACTION:
+                case NETWORK_COMMAND_GAMECMD:
+                    skipCommands--;
+                    continue;
+                case NETWORK_COMMAND_TICK:
+                case NETWORK_COMMAND_TICK_BATCH:
+                    // The tick ran before the client has seen all of the commands it claims to have run.
+                    return false;
+                default:
+                    break;
+            }
+        }
+        packets.push_back(it->Payload);
+    }
+    return skipCommands == 0;
+}
+
+void NetworkResyncHistory::SetHash(uint32_t tick, const std::string& hash)
+{
+    _hashes[tick] = hash;
+}
+
+bool NetworkResyncHistory::IsConfirmed(uint32_t tick, const std::string& hash) const
+{
+    auto it = _hashes.find(tick);
+    return it != _hashes.end() && it->second == hash;
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+#    include "../common.h"
+#    include "NetworkPacket.h"
+
+#    include <deque>
+#    include <map>
+#    include <string>
+#    include <vector>
+
+/**
+ * The game stream the server sent during the last ticks. Clients that lost the connection continue from a game state
+ * they saved themselves and receive the packets of the stream they missed, new clients catch up from the map they were
+ * sent. The history is limited both in ticks and in the size of the packets it holds.
+ */
+class NetworkResyncHistory final
+{
+public:
+    NetworkResyncHistory(uint32_t maxTicks, size_t maxSize);
+
+    void Push(uint32_t tick, const NetworkPacketPayloadPtr& payload);
+
+    /**
+     * Forgets every packet, nothing captured before can be continued from the history anymore.
+     */
+    void Reset(uint32_t tick);
+
+    /**
+     * The first tick whose packets are all still in the history.
+     */
+    uint32_t GetFirstTick() const;
+
+    /**
+     * Number of packets ever added to the history, the sequence number of the next one.
+     */
+    uint64_t GetSequence() const;
+    size_t GetCount() const;
+    size_t GetSize() const;
+
+    /**
+     * Returns true if every packet from the given sequence number on is still in the history.
+     */
+    bool Contains(uint64_t sequence) const;
+    std::vector<NetworkPacketPayloadPtr> GetPacketsSince(uint64_t sequence) const;
+
+    /**
+     * Collects the packets a client needs to continue from the start of the given tick. A client stopped while the
+     * game is paused has already run the first game commands of that tick, those are left out. Returns false if the
+     * tick is no longer complete in the history.
+     */
+    bool GetPacketsFrom(uint32_t tick, uint32_t skipCommands, std::vector<NetworkPacketPayloadPtr>& packets) const;
+
+    /**
+     * The state hashes sent to the clients during the history, a client may only continue from a state it matched.
+     */
+    void SetHash(uint32_t tick, const std::string& hash);
+    bool IsConfirmed(uint32_t tick, const std::string& hash) const;
+
+private:
+    struct HistoryPacket
+    {
+        uint32_t Tick = 0;
+        NetworkPacketPayloadPtr Payload;
+    };
+
+    uint32_t _maxTicks;
+    size_t _maxSize;
+    std::deque<HistoryPacket> _packets;
+    size_t _size = 0;
+    uint64_t _sequence = 0;
+    uint32_t _firstTick = 0;
+    std::map<uint32_t, std::string> _hashes;
+};
+
+#endif // DISABLE_NETWORK
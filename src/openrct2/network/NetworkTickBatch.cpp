@@ -0,0 +1,180 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkTickBatch.h"
+
+#    include "../util/Util.h"
+#    include "NetworkTypes.h"
+
+#    include <cstdlib>
+#    include <cstring>
+
+// Type and size of every action.
+constexpr size_t NETWORK_TICK_BATCH_ACTION_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+void NetworkTickBatch::Reset(uint32_t tick, uint32_t srand0, uint32_t flags, const std::string& checksum)
+{
+    Tick = tick;
+    Srand0 = srand0;
+    Flags = flags;
+    Checksum = checksum;
+    _data.clear();
+    _actions.clear();
+}
+
+bool NetworkTickBatch::AddAction(uint32_t type, const uint8_t* data, size_t size)
+{
+    if (_data.size() + NETWORK_TICK_BATCH_ACTION_HEADER_SIZE + size > NETWORK_TICK_BATCH_MAX_SIZE)
+    {
+        return false;
+    }
+
+    WriteUInt32(type);
+    WriteUInt32((uint32_t)size);
+    _actions.push_back({ type, _data.size(), size });
+    _data.insert(_data.end(), data, data + size);
+    return true;
+}
+
+size_t NetworkTickBatch::GetNumActions() const
+{
+    return _actions.size();
+}
+
+NetworkTickBatchAction NetworkTickBatch::GetAction(size_t index) const
+{
+    const auto& entry = _actions[index];
+    return { entry.Type, _data.data() + entry.Offset, entry.Size };
+}
+
+std::unique_ptr<NetworkPacket> NetworkTickBatch::CreatePacket() const
+{
+    uint32_t flags = Flags & ~NETWORK_TICK_FLAG_COMPRESSED;
+    uint8_t* compressed = nullptr;
+    size_t compressedSize = 0;
+    if (_data.size() >= NETWORK_TICK_BATCH_COMPRESS_THRESHOLD)
+    {
+        compressed = util_zlib_deflate(_data.data(), _data.size(), &compressedSize);
+        if (compressed != nullptr && compressedSize < _data.size())
+        {
+            flags |= NETWORK_TICK_FLAG_COMPRESSED;
+        }
+    }
+
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << (uint32_t)NETWORK_COMMAND_TICK_BATCH << Tick << Srand0 << flags;
+    if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    {
+        packet->WriteString(Checksum.c_str());
+    }
+    *packet << (uint32_t)_actions.size();
+    if (flags & NETWORK_TICK_FLAG_COMPRESSED)
+    {
+        *packet << (uint32_t)_data.size();
+        packet->Write(compressed, compressedSize);
+    }
+    else
+    {
+        packet->Write(_data.data(), _data.size());
+    }
+    free(compressed);
+    return packet;
+}
+
+bool NetworkTickBatch::Read(NetworkPacket& packet)
+{
+    uint32_t numActions = 0;
+    packet >> Tick >> Srand0 >> Flags;
+    Checksum.clear();
+    if (Flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    {
+        const char* text = packet.ReadString();
+        if (text == nullptr)
+        {
+            return false;
+        }
+        Checksum = text;
+    }
+    packet >> numActions;
+
+    _data.clear();
+    _actions.clear();
+    if (Flags & NETWORK_TICK_FLAG_COMPRESSED)
+    {
+        uint32_t uncompressedSize = 0;
+        packet >> uncompressedSize;
+        size_t size = packet.Size - packet.BytesRead;
+        const uint8_t* compressed = packet.Read(size);
+        if (compressed == nullptr || uncompressedSize > NETWORK_TICK_BATCH_MAX_SIZE)
+        {
+            return false;
+        }
+
+        size_t outSize = uncompressedSize;
+        uint8_t* data = util_zlib_inflate(const_cast<uint8_t*>(compressed), size, &outSize);
+        if (data == nullptr)
+        {
+            return false;
+        }
+        _data.assign(data, data + outSize);
+        free(data);
+        if (outSize != uncompressedSize)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        size_t size = packet.Size - packet.BytesRead;
+        const uint8_t* data = packet.Read(size);
+        if (data != nullptr)
+        {
+            _data.assign(data, data + size);
+        }
+    }
+    return IndexActions(numActions);
+}
+
+void NetworkTickBatch::WriteUInt32(uint32_t value)
+{
+    uint32_t swapped = ByteSwapBE(value);
+    const uint8_t* bytes = (const uint8_t*)&swapped;
+    _data.insert(_data.end(), bytes, bytes + sizeof(swapped));
+}
+
+bool NetworkTickBatch::IndexActions(uint32_t numActions)
+{
+    size_t offset = 0;
+    for (uint32_t i = 0; i < numActions; i++)
+    {
+        if (_data.size() - offset < NETWORK_TICK_BATCH_ACTION_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        uint32_t type, size;
+        std::memcpy(&type, &_data[offset], sizeof(type));
+        std::memcpy(&size, &_data[offset + sizeof(type)], sizeof(size));
+        type = ByteSwapBE(type);
+        size = ByteSwapBE(size);
+        offset += NETWORK_TICK_BATCH_ACTION_HEADER_SIZE;
+        if (_data.size() - offset < size)
+        {
+            return false;
+        }
+
+        _actions.push_back({ type, offset, size });
+        offset += size;
+    }
+    return offset == _data.size();
+}
+
+#endif
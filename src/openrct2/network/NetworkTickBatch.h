@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+#    include "../common.h"
+#    include "NetworkPacket.h"
+
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+enum
+{
+    NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_COMPRESSED = 1 << 1,
+};
+
+// Serialised actions above this size are compressed, smaller batches would barely shrink.
+constexpr size_t NETWORK_TICK_BATCH_COMPRESS_THRESHOLD = 256;
+// Keeps the batch well inside the limit of a single packet, even when it can not be compressed.
+constexpr size_t NETWORK_TICK_BATCH_MAX_SIZE = 48 * 1024;
+
+struct NetworkTickBatchAction
+{
+    uint32_t Type;
+    const uint8_t* Data;
+    size_t Size;
+};
+
+/**
+ * Everything a client needs to run one server tick: the tick number, the random seed, the optional sprite checksum and
+ * every game action the server executed during that tick. It is sent as a single NETWORK_COMMAND_TICK_BATCH packet at
+ * the end of the tick instead of one TICK packet followed by a GAME_ACTION packet per action.
+ */
+class NetworkTickBatch final
+{
+public:
+    uint32_t Tick = 0;
+    uint32_t Srand0 = 0;
+    uint32_t Flags = 0;
+    std::string Checksum;
+
+    void Reset(uint32_t tick, uint32_t srand0, uint32_t flags, const std::string& checksum);
+
+    /**
+     * Returns false if the action does not fit into the batch anymore.
+     */
+    bool AddAction(uint32_t type, const uint8_t* data, size_t size);
+    size_t GetNumActions() const;
+    NetworkTickBatchAction GetAction(size_t index) const;
+
+    std::unique_ptr<NetworkPacket> CreatePacket() const;
+
+    /**
+     * Reads the batch from a packet whose command has already been read, returns false if the packet is malformed.
+     */
+    bool Read(NetworkPacket& packet);
+
+private:
+    struct ActionEntry
+    {
+        uint32_t Type;
+        size_t Offset;
+        size_t Size;
+    };
+
+    // The serialised actions exactly as they are sent, each one prefixed with its type and size.
+    std::vector<uint8_t> _data;
+    std::vector<ActionEntry> _actions;
+
+    void WriteUInt32(uint32_t value);
+    bool IndexActions(uint32_t numActions);
+};
+
+#endif // DISABLE_NETWORK
@@ -12,6 +12,8 @@
 #include "../common.h"
 #include "../core/Endianness.h"
 
+#include <algorithm>
+
 enum
 {
     NETWORK_MODE_NONE,
@@ -68,6 +70,9 @@ enum NETWORK_COMMAND
     NETWORK_COMMAND_PLAYERINFO,
     NETWORK_COMMAND_REQUEST_GAMESTATE,
     NETWORK_COMMAND_GAMESTATE,
+    NETWORK_COMMAND_TICK_BATCH,
+    NETWORK_COMMAND_OBJECT_DATA,
+    NETWORK_COMMAND_RESYNC,
     NETWORK_COMMAND_MAX,
     NETWORK_COMMAND_INVALID = -1
 };
@@ -126,8 +131,79 @@ enum NetworkStatisticsGroup
     NETWORK_STATISTICS_GROUP_MAX,
 };
 
+constexpr size_t NETWORK_HISTOGRAM_BUCKETS = 16;
+
+// Bucket 0 counts zeros, bucket n counts values below 2^n and the last bucket everything beyond.
+struct NetworkHistogram_t
+{
+    uint64_t buckets[NETWORK_HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+    uint32_t max;
+
+    static uint32_t GetBucketLimit(size_t bucket)
+    {
+        return bucket == 0 ? 1 : 1u << bucket;
+    }
+
+    void Add(uint32_t value)
+    {
+        size_t bucket = 0;
+        while (bucket < NETWORK_HISTOGRAM_BUCKETS - 1 && value >= GetBucketLimit(bucket))
+        {
+            bucket++;
+        }
+        buckets[bucket]++;
+        count++;
+        sum += value;
+        max = std::max(max, value);
+    }
+
+    void Add(const NetworkHistogram_t& other)
+    {
+        for (size_t i = 0; i < NETWORK_HISTOGRAM_BUCKETS; i++)
+        {
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        sum += other.sum;
+        max = std::max(max, other.max);
+    }
+};
+
+struct NetworkCommandStats_t
+{
+    uint64_t packetsReceived;
+    uint64_t bytesReceived;
+    uint64_t packetsSent;
+    uint64_t bytesSent;
+};
+
 struct NetworkStats_t
 {
     uint64_t bytesReceived[NETWORK_STATISTICS_GROUP_MAX];
     uint64_t bytesSent[NETWORK_STATISTICS_GROUP_MAX];
+    NetworkCommandStats_t commands[NETWORK_COMMAND_MAX];
+    // Packets waiting to be sent at the end of each tick.
+    NetworkHistogram_t sendQueueDepth;
+    // Milliseconds until a ping was answered.
+    NetworkHistogram_t roundTripTime;
+
+    void Add(const NetworkStats_t& other)
+    {
+        for (size_t i = 0; i < NETWORK_STATISTICS_GROUP_MAX; i++)
+        {
+            bytesReceived[i] += other.bytesReceived[i];
+            bytesSent[i] += other.bytesSent[i];
+        }
+        for (size_t i = 0; i < NETWORK_COMMAND_MAX; i++)
+        {
+            commands[i].packetsReceived += other.commands[i].packetsReceived;
+            commands[i].bytesReceived += other.commands[i].bytesReceived;
+            commands[i].packetsSent += other.commands[i].packetsSent;
+            commands[i].bytesSent += other.commands[i].bytesSent;
+        }
+        sendQueueDepth.Add(other.sendQueueDepth);
+        roundTripTime.Add(other.roundTripTime);
+    }
 };
@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <chrono>
 #    include <cmath>
 #    include <cstring>
@@ -45,6 +46,7 @@
     #include <netinet/tcp.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -53,6 +55,9 @@
     #define closesocket close
     #define ioctlsocket ioctl
     #if defined(__linux__)
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
+        #include <unistd.h>
         #define FLAG_NO_PIPE MSG_NOSIGNAL
     #else
         #define FLAG_NO_PIPE 0
@@ -64,6 +69,9 @@
 
 constexpr auto CONNECT_TIMEOUT = std::chrono::milliseconds(3000);
 
+// Number of buffers passed to a single vectored send, well below the iovec limit of the supported platforms.
+constexpr size_t MAX_SEND_BUFFERS = 64;
+
 #    ifdef _WIN32
 static bool _wsaInitialised = false;
 #    endif
@@ -487,6 +495,60 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SOCKET_STATUS_CONNECTED)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        size_t totalSent = 0;
+        while (count > 0)
+        {
+            size_t batchCount = std::min(count, MAX_SEND_BUFFERS);
+            size_t batchSize = 0;
+#    ifdef _WIN32
+            WSABUF wsaBuffers[MAX_SEND_BUFFERS];
+            for (size_t i = 0; i < batchCount; i++)
+            {
+                wsaBuffers[i].buf = (CHAR*)buffers[i].Data;
+                wsaBuffers[i].len = (ULONG)buffers[i].Size;
+                batchSize += buffers[i].Size;
+            }
+            DWORD sentBytes = 0;
+            if (WSASend(_socket, wsaBuffers, (DWORD)batchCount, &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    else
+            iovec iovecs[MAX_SEND_BUFFERS];
+            for (size_t i = 0; i < batchCount; i++)
+            {
+                iovecs[i].iov_base = (void*)buffers[i].Data;
+                iovecs[i].iov_len = buffers[i].Size;
+                batchSize += buffers[i].Size;
+            }
+            msghdr msg{};
+            msg.msg_iov = iovecs;
+            msg.msg_iovlen = batchCount;
+            ssize_t sentBytes = sendmsg(_socket, &msg, FLAG_NO_PIPE);
+            if (sentBytes == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    endif
+            totalSent += (size_t)sentBytes;
+            if ((size_t)sentBytes < batchSize)
+            {
+                // Socket buffer is full, try again on the next flush.
+                break;
+            }
+            buffers += batchCount;
+            count -= batchCount;
+        }
+        return totalSent;
+    }
+
     NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SOCKET_STATUS_CONNECTED)
@@ -545,6 +607,11 @@ public:
         return _hostName.empty() ? nullptr : _hostName.c_str();
     }
 
+    SOCKET GetSocket() const
+    {
+        return _socket;
+    }
+
 private:
     explicit TcpSocket(SOCKET socket, const std::string& hostName)
     {
@@ -809,6 +876,118 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+#    if defined(__linux__)
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    int _wakeEvent = -1;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+
+        _wakeEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_wakeEvent == -1)
+        {
+            close(_epoll);
+            throw SocketException("Unable to create wake event.");
+        }
+
+        // Wake ups are reported with the poller itself as user data so they can be told apart from sockets.
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = this;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeEvent, &ev);
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_wakeEvent);
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.ptr = userData;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, GetSocket(socket), &ev) != 0)
+        {
+            throw SocketException("Unable to add socket to epoll.");
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, GetSocket(socket), nullptr);
+    }
+
+    size_t Wait(SocketPollEvent* events, size_t maxEvents, int32_t timeoutMs) override
+    {
+        constexpr size_t MaxEpollEvents = 64;
+        epoll_event epollEvents[MaxEpollEvents];
+        int numEvents = epoll_wait(_epoll, epollEvents, (int)std::min(maxEvents, MaxEpollEvents), timeoutMs);
+
+        size_t count = 0;
+        for (int i = 0; i < numEvents; i++)
+        {
+            const auto& ev = epollEvents[i];
+            if (ev.data.ptr == this)
+            {
+                uint64_t value;
+                [[maybe_unused]] auto readBytes = read(_wakeEvent, &value, sizeof(value));
+                continue;
+            }
+
+            // Errors and hang ups are reported as readable so the reader finds out about them.
+            SocketPollEvent& e = events[count++];
+            e.UserData = ev.data.ptr;
+            e.Readable = (ev.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+            e.Writable = (ev.events & EPOLLOUT) != 0;
+        }
+        return count;
+    }
+
+    void Wake() override
+    {
+        uint64_t value = 1;
+        [[maybe_unused]] auto writtenBytes = write(_wakeEvent, &value, sizeof(value));
+    }
+
+private:
+    static SOCKET GetSocket(ITcpSocket& socket)
+    {
+        auto tcpSocket = dynamic_cast<TcpSocket*>(&socket);
+        if (tcpSocket == nullptr)
+        {
+            throw std::invalid_argument("socket is not compatible.");
+        }
+        return tcpSocket->GetSocket();
+    }
+};
+#    endif
+
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+#    if defined(__linux__)
+    try
+    {
+        return std::make_unique<EpollSocketPoller>();
+    }
+    catch (const std::exception& ex)
+    {
+        log_error("%s", ex.what());
+    }
+#    endif
+    return nullptr;
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
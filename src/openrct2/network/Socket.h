@@ -32,6 +32,15 @@ enum NETWORK_READPACKET
     NETWORK_READPACKET_DISCONNECTED
 };
 
+/**
+ * A block of memory to be sent as part of a vectored send.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents an address and port.
  */
@@ -64,6 +73,11 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    /**
+     * Sends the given buffers back to back using as few system calls as possible. Returns the total number of bytes
+     * sent, which is less than the combined size if the socket would block.
+     */
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void Disconnect() abstract;
@@ -93,10 +107,40 @@ public:
     virtual void Close() abstract;
 };
 
+struct SocketPollEvent
+{
+    void* UserData;
+    bool Readable;
+    bool Writable;
+};
+
+/**
+ * Waits for any number of TCP sockets to become readable or writable. Readiness is edge triggered, so a socket has to
+ * be read or written until it would block before it is reported again.
+ */
+interface ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket, void* userData) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+
+    /**
+     * Waits until a socket is ready, Wake is called or the timeout expires. Returns the number of events written.
+     */
+    virtual size_t Wait(SocketPollEvent* events, size_t maxEvents, int32_t timeoutMs) abstract;
+    virtual void Wake() abstract;
+};
+
 bool InitialiseWSA();
 void DisposeWSA();
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+/**
+ * Returns nullptr if the platform has no suitable polling mechanism.
+ */
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
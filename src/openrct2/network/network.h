@@ -20,6 +20,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 struct json_t;
 struct GameAction;
@@ -40,6 +42,7 @@ void network_reconnect();
 void network_shutdown_client();
 int32_t network_begin_client(const std::string& host, int32_t port);
 int32_t network_begin_server(int32_t port, const std::string& address);
+int32_t network_begin_relay(const std::string& host, int32_t port, int32_t listenPort, const std::string& address);
 
 int32_t network_get_mode();
 int32_t network_get_status();
@@ -112,7 +115,10 @@ const utf8* network_get_server_provider_email();
 const utf8* network_get_server_provider_website();
 
 std::string network_get_version();
+const char* network_get_command_name(int32_t command);
 
 NetworkStats_t network_get_stats();
+std::vector<std::pair<std::string, NetworkStats_t>> network_get_connection_stats();
+std::string network_dump_stats();
 NetworkServerState_t network_get_server_state();
 json_t* network_get_server_info_as_json();
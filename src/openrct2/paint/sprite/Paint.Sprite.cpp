@@ -34,8 +34,8 @@ void sprite_paint_setup(paint_session* session, const uint16_t x, const uint16_t
         return;
     }
 
-    uint16_t sprite_idx = sprite_get_first_in_quadrant(x, y);
-    if (sprite_idx == SPRITE_INDEX_NULL)
+    const auto& bucket = sprite_get_tile_bucket(x, y);
+    if (bucket.empty())
     {
         return;
     }
@@ -48,10 +48,10 @@ void sprite_paint_setup(paint_session* session, const uint16_t x, const uint16_t
 
     const bool highlightPathIssues = (session->ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES);
 
-    for (const rct_sprite* spr = get_sprite(sprite_idx); sprite_idx != SPRITE_INDEX_NULL;
-         sprite_idx = spr->generic.next_in_quadrant)
+    // The bucket is in reverse quadrant order, walk it backwards to paint the sprites in the same order as before.
+    for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
     {
-        spr = get_sprite(sprite_idx);
+        const rct_sprite* spr = get_sprite(it->SpriteIndex);
 
         if (highlightPathIssues)
         {
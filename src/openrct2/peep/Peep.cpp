@@ -438,13 +438,17 @@ void peep_update_all()
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
-    spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
+    // Walked from the back to visit the peeps in list order, peeps added meanwhile are appended and not visited. Renames
+    // relink the list and rebuild the array, they happen in game actions and never during this loop.
+    const auto& peeps = sprite_list_get_dense(SPRITE_LIST_PEEP);
     i = 0;
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    for (size_t j = peeps.size(); j > 0; j--)
     {
-        peep = &(get_sprite(spriteIndex)->peep);
-        spriteIndex = peep->next;
+        spriteIndex = peeps[j - 1];
+        if (spriteIndex == SPRITE_INDEX_NULL)
+            continue;
 
+        peep = &(get_sprite(spriteIndex)->peep);
         if ((uint32_t)(i & 0x7F) != (gCurrentTicks & 0x7F))
         {
             peep->Update();
@@ -3603,6 +3607,7 @@ void peep_update_name_sort(Peep* peep)
 finish_peep_sort:
     // This is required at the moment because this function reorders peeps in the sprite list
     sprite_position_tween_reset();
+    reset_sprite_list_order(SPRITE_LIST_PEEP);
 }
 
 void peep_sort()
@@ -3639,6 +3644,7 @@ void peep_sort()
     gSpriteListHead[SPRITE_LIST_PEEP] = peep_list[0];
 
     free(peep_list);
+    reset_sprite_list_order(SPRITE_LIST_PEEP);
 
     i = 0;
     FOR_ALL_PEEPS (sprite_index, peep)
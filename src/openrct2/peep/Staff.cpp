@@ -82,6 +82,44 @@ void staff_reset_modes()
     staff_update_greyed_patrol_areas();
 }
 
+// The staff of each type in the order of the peep list, so looking for staff does not have to walk past every guest.
+static std::vector<uint16_t> _staffIndex[STAFF_TYPE_COUNT];
+
+/**
+ * Rebuilds the staff index from the peep list. Looking for staff breaks ties by list order, so this has to run whenever
+ * the peep list is loaded or relinked, for example when staff are hired or renamed.
+ */
+void staff_index_reset()
+{
+    for (auto& staffOfType : _staffIndex)
+    {
+        staffOfType.clear();
+    }
+
+    uint16_t spriteIndex;
+    Peep* peep;
+    FOR_ALL_STAFF (spriteIndex, peep)
+    {
+        if (peep->staff_type < STAFF_TYPE_COUNT)
+        {
+            _staffIndex[peep->staff_type].push_back(spriteIndex);
+        }
+    }
+}
+
+void staff_index_remove(Peep* peep)
+{
+    for (auto& staffOfType : _staffIndex)
+    {
+        staffOfType.erase(std::remove(staffOfType.begin(), staffOfType.end(), peep->sprite_index), staffOfType.end());
+    }
+}
+
+const std::vector<uint16_t>& staff_get_all_of_type(uint8_t staffType)
+{
+    return _staffIndex[staffType];
+}
+
 /**
  * Hires a new staff member of the given type.
  */
@@ -421,24 +459,8 @@ void staff_toggle_patrol_area(int32_t staffIndex, int32_t x, int32_t y)
  */
 static uint8_t staff_handyman_direction_to_nearest_litter(Peep* peep)
 {
-    uint16_t nearestLitterDist = (uint16_t)-1;
-    rct_litter* nearestLitter = nullptr;
-    rct_litter* litter = nullptr;
-
-    for (uint16_t litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
-    {
-        litter = &get_sprite(litterIndex)->litter;
-
-        uint16_t distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
-        }
-    }
-
-    if (nearestLitterDist > 0x60)
+    rct_litter* nearestLitter = litter_get_nearest(peep->x, peep->y, peep->z, 0x60);
+    if (nearestLitter == nullptr)
     {
         return 0xFF;
     }
@@ -1004,27 +1026,22 @@ static bool staff_path_finding_misc(Peep* peep)
  */
 static void staff_entertainer_update_nearby_peeps(Peep* peep)
 {
-    uint16_t spriteIndex;
-    Peep* guest;
+    if (peep->x == LOCATION_NULL)
+        return;
 
-    FOR_ALL_GUESTS (spriteIndex, guest)
+    std::vector<uint16_t> nearby;
+    sprite_get_in_range(peep->x, peep->y, 96, nearby);
+    for (uint16_t spriteIndex : nearby)
     {
-        if (guest->x == LOCATION_NULL)
+        rct_sprite* sprite = get_sprite(spriteIndex);
+        if (sprite->generic.linked_list_type_offset != SPRITE_LIST_PEEP * 2 || sprite->peep.type != PEEP_TYPE_GUEST)
             continue;
 
+        Peep* guest = &sprite->peep;
         int16_t z_dist = abs(peep->z - guest->z);
         if (z_dist > 48)
             continue;
 
-        int16_t x_dist = abs(peep->x - guest->x);
-        int16_t y_dist = abs(peep->y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
-
         if (peep->state == PEEP_STATE_WALKING)
         {
             peep->happiness_target = std::min(peep->happiness_target + 4, PEEP_MAX_HAPPINESS);
@@ -1231,6 +1248,8 @@ void Staff::UpdateMowing()
         if (surfaceElement != nullptr && surfaceElement->CanGrassGrow())
         {
             surfaceElement->SetGrassLength(GRASS_LENGTH_MOWED);
+            // Mowed grass grows again, the tile is no longer idle.
+            map_invalidate_idle_tile(next_x / 32, next_y / 32);
             map_invalidate_tile_zoom0(next_x, next_y, surfaceElement->base_height * 8, surfaceElement->base_height * 8 + 16);
         }
         staff_lawns_mown++;
@@ -13,6 +13,8 @@
 #include "../common.h"
 #include "Peep.h"
 
+#include <vector>
+
 #define STAFF_MAX_COUNT 200
 // The number of elements in the gStaffPatrolAreas array per staff member. Every bit in the array represents a 4x4 square.
 // Right now, it's a 32-bit array like in RCT2. 32 * 128 = 4096 bits, which is also the number of 4x4 squares on a 256x256 map.
@@ -90,5 +92,8 @@ colour_t staff_get_colour(uint8_t staffType);
 bool staff_set_colour(uint8_t staffType, colour_t value);
 uint32_t staff_get_available_entertainer_costumes();
 int32_t staff_get_available_entertainer_costume_list(uint8_t* costumeList);
+void staff_index_reset();
+void staff_index_remove(Peep* peep);
+const std::vector<uint16_t>& staff_get_all_of_type(uint8_t staffType);
 
 #endif
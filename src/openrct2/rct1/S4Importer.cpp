@@ -1820,13 +1820,12 @@ private:
     void ImportMapAnimations()
     {
         // This is sketchy, ideally we should try to re-create them
-        rct_map_animation* s4Animations = _s4.map_animations;
-        for (size_t i = 0; i < RCT1_MAX_ANIMATED_OBJECTS; i++)
+        map_animation_reset();
+        for (size_t i = 0; i < std::min<size_t>(_s4.num_map_animations, RCT1_MAX_ANIMATED_OBJECTS); i++)
         {
-            gAnimatedObjects[i] = s4Animations[i];
-            gAnimatedObjects[i].baseZ /= 2;
+            const auto& animation = _s4.map_animations[i];
+            map_animation_create(animation.type, animation.x, animation.y, animation.baseZ / 2);
         }
-        gNumMapAnimations = _s4.num_map_animations;
     }
 
     void ImportFinance()
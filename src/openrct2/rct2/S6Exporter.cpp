@@ -355,8 +355,11 @@ void S6Exporter::Export()
     _s6.saved_view_y = gSavedViewY;
     _s6.saved_view_zoom = gSavedViewZoom;
     _s6.saved_view_rotation = gSavedViewRotation;
-    std::memcpy(_s6.map_animations, gAnimatedObjects, sizeof(_s6.map_animations));
-    _s6.num_map_animations = gNumMapAnimations;
+    // The format only has room for RCT2_MAX_ANIMATED_OBJECTS, the rest are recreated from the map when loaded.
+    auto animations = map_animation_get_all();
+    size_t numAnimations = std::min(animations.size(), std::size(_s6.map_animations));
+    std::copy_n(animations.begin(), numAnimations, _s6.map_animations);
+    _s6.num_map_animations = (uint16_t)numAnimations;
     // pad_0138B582
 
     _s6.ride_ratings_calc_data = gRideRatingsCalcData;
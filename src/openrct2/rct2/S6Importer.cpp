@@ -388,11 +388,12 @@ public:
         gSavedViewZoom = _s6.saved_view_zoom;
         gSavedViewRotation = _s6.saved_view_rotation;
 
-        for (size_t i = 0; i < RCT2_MAX_ANIMATED_OBJECTS; i++)
+        map_animation_reset();
+        for (size_t i = 0; i < std::min<size_t>(_s6.num_map_animations, RCT2_MAX_ANIMATED_OBJECTS); i++)
         {
-            gAnimatedObjects[i] = _s6.map_animations[i];
+            const auto& animation = _s6.map_animations[i];
+            map_animation_create(animation.type, animation.x, animation.y, animation.baseZ);
         }
-        gNumMapAnimations = _s6.num_map_animations;
         // pad_0138B582
 
         gRideRatingsCalcData = _s6.ride_ratings_calc_data;
@@ -468,6 +469,7 @@ public:
         {
             log_error("Found %d disjoint null sprites", disjoint_sprites_count);
         }
+        reset_sprite_list_indices();
 
         if (String::Equals(_s6.scenario_filename, "Europe - European Cultural Festival.SC6"))
         {
@@ -2781,15 +2781,12 @@ Peep* ride_find_closest_mechanic(Ride* ride, int32_t forInspection)
 Peep* find_closest_mechanic(int32_t x, int32_t y, int32_t forInspection)
 {
     uint32_t closestDistance, distance;
-    uint16_t spriteIndex;
-    Peep *peep, *closestMechanic = nullptr;
+    Peep* closestMechanic = nullptr;
 
     closestDistance = UINT_MAX;
-    FOR_ALL_STAFF (spriteIndex, peep)
+    for (auto spriteIndex : staff_get_all_of_type(STAFF_TYPE_MECHANIC))
     {
-        if (peep->staff_type != STAFF_TYPE_MECHANIC)
-            continue;
-
+        Peep* peep = GET_PEEP(spriteIndex);
         if (!forInspection)
         {
             if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION)
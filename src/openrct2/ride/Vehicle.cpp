@@ -42,6 +42,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 static void vehicle_update(rct_vehicle* vehicle);
 static void vehicle_update_crossings(const rct_vehicle* vehicle);
@@ -107,6 +108,9 @@ uint8_t _vehicleBankEndF64E37;
 uint8_t _vehicleF64E2C;
 rct_vehicle* _vehicleFrontVehicle;
 LocationXYZ16 unk_F64E20;
+// The cars of the train in vehicle_update_track_motion, recorded as they are moved so the train totals can be summed
+// from a contiguous array instead of walking the train through the sprite array a second time.
+static std::vector<rct_vehicle*> _vehicleTrainCars;
 
 // clang-format off
 static constexpr const uint8_t byte_9A3A14[] = { SOUND_SCREAM_8, SOUND_SCREAM_1 };
@@ -1339,12 +1343,14 @@ void vehicle_update_all()
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gS6Info.editor_step != EDITOR_STEP_ROLLERCOASTER_DESIGNER)
         return;
 
-    sprite_index = gSpriteListHead[SPRITE_LIST_TRAIN];
-    while (sprite_index != SPRITE_INDEX_NULL)
+    const auto& trains = sprite_list_get_dense(SPRITE_LIST_TRAIN);
+    for (size_t i = trains.size(); i > 0; i--)
     {
-        vehicle = GET_VEHICLE(sprite_index);
-        sprite_index = vehicle->next;
+        sprite_index = trains[i - 1];
+        if (sprite_index == SPRITE_INDEX_NULL)
+            continue;
 
+        vehicle = GET_VEHICLE(sprite_index);
         vehicle_update(vehicle);
     }
 }
@@ -6478,18 +6484,13 @@ bool vehicle_update_dodgems_collision(rct_vehicle* vehicle, int16_t x, int16_t y
         location.x += xy_offset.x;
         location.y += xy_offset.y;
 
-        uint16_t spriteIdx = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-        while (spriteIdx != SPRITE_INDEX_NULL)
+        const auto& bucket = sprite_get_tile_vehicle_bucket(location.x * 32, location.y * 32);
+        for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
         {
-            rct_vehicle* vehicle2 = GET_VEHICLE(spriteIdx);
-            spriteIdx = vehicle2->next_in_quadrant;
-
+            rct_vehicle* vehicle2 = GET_VEHICLE(it->SpriteIndex);
             if (vehicle2 == vehicle)
                 continue;
 
-            if (vehicle2->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
-                continue;
-
             if (vehicle2->ride != rideIndex)
                 continue;
 
@@ -7705,19 +7706,17 @@ static bool vehicle_update_motion_collision_detection(
         location.x += xy_offset.x;
         location.y += xy_offset.y;
 
-        collideId = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-        for (; collideId != SPRITE_INDEX_NULL; collideId = collideVehicle->next_in_quadrant)
+        const auto& bucket = sprite_get_tile_vehicle_bucket(location.x * 32, location.y * 32);
+        for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
         {
-            collideVehicle = GET_VEHICLE(collideId);
-            if (collideVehicle == vehicle)
-                continue;
-
-            if (collideVehicle->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
+            // Most vehicles on the tile are ruled out by height, which the bucket has without touching the sprite.
+            int32_t z_diff = abs(it->z - z);
+            if (z_diff > 16)
                 continue;
 
-            int32_t z_diff = abs(collideVehicle->z - z);
-
-            if (z_diff > 16)
+            collideId = it->SpriteIndex;
+            collideVehicle = GET_VEHICLE(collideId);
+            if (collideVehicle == vehicle)
                 continue;
 
             if (collideVehicle->ride_subtype == RIDE_TYPE_NULL)
@@ -9611,10 +9610,12 @@ int32_t vehicle_update_track_motion(rct_vehicle* vehicle, int32_t* outStation)
     // backwards.
     _vehicleFrontVehicle = vehicle;
 
+    _vehicleTrainCars.clear();
     uint16_t spriteId = vehicle->sprite_index;
     while (spriteId != SPRITE_INDEX_NULL)
     {
         rct_vehicle* car = GET_VEHICLE(spriteId);
+        _vehicleTrainCars.push_back(car);
         vehicleEntry = vehicle_get_vehicle_entry(car);
         if (vehicleEntry == nullptr)
         {
@@ -9719,32 +9720,19 @@ int32_t vehicle_update_track_motion(rct_vehicle* vehicle, int32_t* outStation)
     vehicle = gCurrentVehicle;
 
     vehicleEntry = vehicle_get_vehicle_entry(vehicle);
+    // The loop above moved every car of the train once, from either end, and the totals do not depend on the order.
     // eax
     int32_t totalAcceleration = 0;
     // ebp
     int32_t totalMass = 0;
-    // Not used
-    regs.dx = 0;
     // ebx
-    int32_t numVehicles = 0;
-
-    for (;;)
+    int32_t numVehicles = (int32_t)_vehicleTrainCars.size();
+    for (const rct_vehicle* car : _vehicleTrainCars)
     {
-        numVehicles++;
-        // Not used?
-        regs.dx |= vehicle->update_flags;
-        totalMass += vehicle->mass;
-        totalAcceleration += vehicle->acceleration;
-
-        uint16_t spriteIndex = vehicle->next_vehicle_on_train;
-        if (spriteIndex == SPRITE_INDEX_NULL)
-        {
-            break;
-        }
-        vehicle = GET_VEHICLE(spriteIndex);
+        totalMass += car->mass;
+        totalAcceleration += car->acceleration;
     }
 
-    vehicle = gCurrentVehicle;
     regs.eax = (totalAcceleration / numVehicles) * 21;
     if (regs.eax < 0)
     {
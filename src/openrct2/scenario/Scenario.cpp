@@ -96,6 +96,9 @@ void scenario_begin()
     gParkFlags &= ~PARK_FLAGS_NO_MONEY;
     if (gParkFlags & PARK_FLAGS_NO_MONEY_SCENARIO)
         gParkFlags |= PARK_FLAGS_NO_MONEY;
+    // New games only update wide paths around path changes, saved games keep the mode they were started with.
+    gParkFlags |= PARK_FLAGS_PATH_WIDE_FLAGS_ON_CHANGE;
+    map_reset_path_wide_flags();
     research_reset_current_item();
     scenery_set_default_placement_configuration();
     news_item_init_queue();
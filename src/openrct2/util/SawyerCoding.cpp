@@ -23,7 +23,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
 static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static void encode_chunk_rotate(uint8_t* buffer, size_t length);
 
-bool gUseRLE = true;
+thread_local bool gUseRLE = true;
 
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
 {
@@ -42,7 +42,7 @@ enum
     FILE_TYPE_SC4 = (2 << 2)
 };
 
-extern bool gUseRLE;
+extern thread_local bool gUseRLE;
 
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length);
 size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* src_buffer, sawyercoding_chunk_header chunkHeader);
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 void footpath_update_queue_entrance_banner(int32_t x, int32_t y, TileElement* tileElement);
 
@@ -402,21 +403,25 @@ void footpath_bridge_get_info_from_pos(
  */
 void footpath_remove_litter(int32_t x, int32_t y, int32_t z)
 {
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    // Collect the litter first, removing it changes the bucket.
+    std::vector<rct_sprite*> litter;
+    const auto& bucket = sprite_get_tile_bucket(x, y);
+    for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
     {
-        rct_litter* sprite = &get_sprite(spriteIndex)->litter;
-        uint16_t nextSpriteIndex = sprite->next_in_quadrant;
-        if (sprite->linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+        if (abs(it->z - z) <= 32)
         {
-            int32_t distanceZ = abs(sprite->z - z);
-            if (distanceZ <= 32)
+            rct_sprite* sprite = get_sprite(it->SpriteIndex);
+            if (sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
             {
-                invalidate_sprite_0((rct_sprite*)sprite);
-                sprite_remove((rct_sprite*)sprite);
+                litter.push_back(sprite);
             }
         }
-        spriteIndex = nextSpriteIndex;
+    }
+
+    for (auto sprite : litter)
+    {
+        invalidate_sprite_0(sprite);
+        sprite_remove(sprite);
     }
 }
 
@@ -426,26 +431,28 @@ void footpath_remove_litter(int32_t x, int32_t y, int32_t z)
  */
 void footpath_interrupt_peeps(int32_t x, int32_t y, int32_t z)
 {
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    std::vector<Peep*> peeps;
+    const auto& bucket = sprite_get_tile_bucket(x, y);
+    for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
     {
-        Peep* peep = &get_sprite(spriteIndex)->peep;
-        uint16_t nextSpriteIndex = peep->next_in_quadrant;
-        if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2)
+        if (it->z == z)
         {
-            if (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING)
+            Peep* peep = &get_sprite(it->SpriteIndex)->peep;
+            if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2
+                && (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING))
             {
-                if (peep->z == z)
-                {
-                    peep->SetState(PEEP_STATE_WALKING);
-                    peep->destination_x = (peep->x & 0xFFE0) + 16;
-                    peep->destination_y = (peep->y & 0xFFE0) + 16;
-                    peep->destination_tolerance = 5;
-                    peep->UpdateCurrentActionSpriteType();
-                }
+                peeps.push_back(peep);
             }
         }
-        spriteIndex = nextSpriteIndex;
+    }
+
+    for (auto peep : peeps)
+    {
+        peep->SetState(PEEP_STATE_WALKING);
+        peep->destination_x = (peep->x & 0xFFE0) + 16;
+        peep->destination_y = (peep->y & 0xFFE0) + 16;
+        peep->destination_tolerance = 5;
+        peep->UpdateCurrentActionSpriteType();
     }
 }
 
@@ -966,6 +973,18 @@ static void loc_6A6C85(
     loc_6A6D7E(x, y, z, direction, tileElement, flags, query, neighbourList);
 }
 
+/**
+ * Queues the wide flags around a path whose edges change, along with the neighbouring paths it connects to.
+ */
+static void footpath_queue_wide_flags_update(int32_t x, int32_t y)
+{
+    map_queue_path_wide_flags_update(x, y);
+    for (int32_t direction = 0; direction < 4; direction++)
+    {
+        map_queue_path_wide_flags_update(x + CoordsDirectionDelta[direction].x, y + CoordsDirectionDelta[direction].y);
+    }
+}
+
 /**
  *
  *  rct2: 0x006A6C66
@@ -976,6 +995,7 @@ void footpath_connect_edges(int32_t x, int32_t y, TileElement* tileElement, int3
     rct_neighbour neighbour;
 
     footpath_update_queue_chains();
+    footpath_queue_wide_flags_update(x, y);
 
     neighbour_list_init(&neighbourList);
 
@@ -2097,6 +2117,7 @@ void footpath_remove_edges_at(int32_t x, int32_t y, TileElement* tileElement)
     }
 
     footpath_update_queue_entrance_banner(x, y, tileElement);
+    footpath_queue_wide_flags_update(x, y);
 
     bool fixCorners = false;
     for (uint8_t direction = 0; direction < 4; direction++)
@@ -56,7 +56,9 @@
 #include "Wall.h"
 
 #include <algorithm>
+#include <bitset>
 #include <iterator>
+#include <set>
 
 using namespace OpenRCT2;
 
@@ -80,7 +82,15 @@ uint8_t gMapGroundFlags;
 
 uint16_t gWidePathTileLoopX;
 uint16_t gWidePathTileLoopY;
+
+// Tiles whose path wide flags have to be updated, keyed so that they are updated in the same order as the legacy sweep.
+// A tile only looks at the wide flags of tiles that come before it, so those are always final when it is updated.
+static std::set<uint32_t> _pathWideFlagsQueue;
 uint16_t gGrassSceneryTileLoopPosition;
+// Tiles that map_update_tiles found to have nothing to update until the map changes, so it can skip them.
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _idleTiles;
+// Set while a game action changes the map, every tile it looks at may have changed and is no longer known to be idle.
+static bool _idleTilesTrackChanges;
 
 int16_t gMapSizeUnits;
 int16_t gMapSizeMinus2;
@@ -217,6 +227,10 @@ TileElement* map_get_first_element_at(int32_t x, int32_t y)
         log_error("Trying to access element outside of range");
         return nullptr;
     }
+    if (_idleTilesTrackChanges)
+    {
+        _idleTiles.reset(x * MAXIMUM_MAP_SIZE_TECHNICAL + y);
+    }
     return gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
 }
 
@@ -333,7 +347,7 @@ BannerElement* map_get_banner_element_at(int32_t x, int32_t y, int32_t z, uint8_
  */
 void map_init(int32_t size)
 {
-    gNumMapAnimations = 0;
+    map_animation_reset();
     gNextFreeTileElementPointerIndex = 0;
 
     for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
@@ -353,6 +367,8 @@ void map_init(int32_t size)
     }
 
     gGrassSceneryTileLoopPosition = 0;
+    map_invalidate_idle_tiles();
+    park_reset_size_tiles();
     gWidePathTileLoopX = 0;
     gWidePathTileLoopY = 0;
     gMapSizeUnits = size * 32 - 32;
@@ -675,6 +691,69 @@ bool map_coord_is_connected(int32_t x, int32_t y, int32_t z, uint8_t faceDirecti
     return false;
 }
 
+static uint32_t map_get_path_wide_flags_key(int32_t tileX, int32_t tileY)
+{
+    return (tileY << 8) | tileX;
+}
+
+/**
+ * Returns a mask of which path elements on the tile are wide.
+ */
+static uint64_t map_get_path_wide_mask(int32_t x, int32_t y)
+{
+    uint64_t mask = 0;
+    uint32_t index = 0;
+    TileElement* tileElement = map_get_first_element_at(x / 32, y / 32);
+    do
+    {
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && tileElement->AsPath()->IsWide())
+        {
+            mask |= 1ULL << (index & 63);
+        }
+        index++;
+    } while (!(tileElement++)->IsLastForTile());
+    return mask;
+}
+
+/**
+ * Queues the wide flags of the paths on and around the given tile to be updated, for when the paths on it have changed.
+ */
+void map_queue_path_wide_flags_update(int32_t x, int32_t y)
+{
+    int32_t tileX = x / 32;
+    int32_t tileY = y / 32;
+    for (int32_t offsetY = -1; offsetY <= 1; offsetY++)
+    {
+        for (int32_t offsetX = -1; offsetX <= 1; offsetX++)
+        {
+            int32_t queueX = tileX + offsetX;
+            int32_t queueY = tileY + offsetY;
+            if (queueX >= 0 && queueY >= 0 && queueX < MAXIMUM_MAP_SIZE_TECHNICAL && queueY < MAXIMUM_MAP_SIZE_TECHNICAL)
+            {
+                _pathWideFlagsQueue.insert(map_get_path_wide_flags_key(queueX, queueY));
+            }
+        }
+    }
+}
+
+/**
+ * Brings the wide flags of the whole map up to date, for when it has been loaded.
+ */
+void map_reset_path_wide_flags()
+{
+    _pathWideFlagsQueue.clear();
+    if (gParkFlags & PARK_FLAGS_PATH_WIDE_FLAGS_ON_CHANGE)
+    {
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL * 32; y += 32)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL * 32; x += 32)
+            {
+                footpath_update_path_wide_flags(x, y);
+            }
+        }
+    }
+}
+
 /**
  *
  *  rct2: 0x006A876D
@@ -686,6 +765,42 @@ void map_update_path_wide_flags()
         return;
     }
 
+    if (gParkFlags & PARK_FLAGS_PATH_WIDE_FLAGS_ON_CHANGE)
+    {
+        // Only update the tiles around path changes. When a tile's wide flags change, the tiles that look at them
+        // come after it and are updated in the same pass.
+        while (!_pathWideFlagsQueue.empty())
+        {
+            uint32_t key = *_pathWideFlagsQueue.begin();
+            _pathWideFlagsQueue.erase(_pathWideFlagsQueue.begin());
+
+            int32_t tileX = key & 0xFF;
+            int32_t tileY = key >> 8;
+            int32_t x = tileX * 32;
+            int32_t y = tileY * 32;
+            uint64_t wideMask = map_get_path_wide_mask(x, y);
+            footpath_update_path_wide_flags(x, y);
+            if (map_get_path_wide_mask(x, y) != wideMask)
+            {
+                static const TileCoordsXY dependants[] = { { +1, 0 }, { -1, +1 }, { 0, +1 }, { +1, +1 } };
+                for (const auto& offset : dependants)
+                {
+                    int32_t dependantX = tileX + offset.x;
+                    int32_t dependantY = tileY + offset.y;
+                    if (dependantX >= 0 && dependantX < MAXIMUM_MAP_SIZE_TECHNICAL && dependantY < MAXIMUM_MAP_SIZE_TECHNICAL)
+                    {
+                        _pathWideFlagsQueue.insert(map_get_path_wide_flags_key(dependantX, dependantY));
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Parks from before PARK_FLAGS_PATH_WIDE_FLAGS_ON_CHANGE keep the original sweep, as peeps see the wide flags
+    // change at different times.
+    _pathWideFlagsQueue.clear();
+
     // Presumably update_path_wide_flags is too computationally expensive to call for every
     // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
     // progress. A maximum of 128 calls is done per update.
@@ -1228,6 +1343,10 @@ TileElement* tile_element_insert(int32_t x, int32_t y, int32_t z, int32_t flags)
 
     newTileElement = gNextFreeTileElement;
     originalTileElement = gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    if (_idleTilesTrackChanges)
+    {
+        _idleTiles.reset(x * MAXIMUM_MAP_SIZE_TECHNICAL + y);
+    }
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newTileElement;
@@ -1523,6 +1642,58 @@ int32_t map_can_construct_at(int32_t x, int32_t y, int32_t zLow, int32_t zHigh,
     return map_can_construct_with_clear_at(x, y, zLow, zHigh, nullptr, bl, 0, nullptr, CREATE_CROSSING_MODE_NONE);
 }
 
+/**
+ * Whether updating the tile does nothing until the map changes: there is no small scenery to age, no path addition that
+ * can start a fountain and the grass stays as it is.
+ */
+static bool map_tile_is_idle(int32_t x, int32_t y, TileElement* surfaceElement)
+{
+    if (surfaceElement == nullptr)
+        return true;
+
+    TileElement* tileElement = map_get_first_element_at(x, y);
+    do
+    {
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_SMALL_SCENERY)
+            return false;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && tileElement->AsPath()->HasAddition())
+            return false;
+    } while (!(tileElement++)->IsLastForTile());
+
+    return surfaceElement->AsSurface()->IsGrassIdle({ x * 32, y * 32 });
+}
+
+/**
+ * Forgets which tiles map_update_tiles found idle, for when the map may have changed.
+ */
+void map_invalidate_idle_tiles()
+{
+    _idleTiles.reset();
+}
+
+/**
+ * Forgets whether a single tile was idle, for changes made outside of game actions.
+ */
+void map_invalidate_idle_tile(int32_t x, int32_t y)
+{
+    if (x >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y >= 0 && y < MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        _idleTiles.reset(x * MAXIMUM_MAP_SIZE_TECHNICAL + y);
+    }
+}
+
+/**
+ * While enabled, every tile whose elements are looked at is forgotten as idle. A game action can only change the tiles
+ * it looks at, so this clears exactly the tiles it may have changed. Returns whether it was enabled before, so nested
+ * actions can restore it.
+ */
+bool map_track_idle_tile_changes(bool enabled)
+{
+    bool wasEnabled = _idleTilesTrackChanges;
+    _idleTilesTrackChanges = enabled;
+    return wasEnabled;
+}
+
 /**
  * Updates grass length, scenery age and jumping fountains.
  *
@@ -1549,11 +1720,17 @@ void map_update_tiles()
             interleaved_xy >>= 1;
         }
 
-        TileElement* tileElement = map_get_surface_element_at(x, y);
-        if (tileElement != nullptr)
+        // Idle tiles are skipped without changing the order or rate at which the others are updated.
+        size_t tileIndex = x * MAXIMUM_MAP_SIZE_TECHNICAL + y;
+        if (!_idleTiles.test(tileIndex))
         {
-            tileElement->AsSurface()->UpdateGrassLength({ x * 32, y * 32 });
-            scenery_update_tile(x * 32, y * 32);
+            TileElement* tileElement = map_get_surface_element_at(x, y);
+            if (tileElement != nullptr)
+            {
+                tileElement->AsSurface()->UpdateGrassLength({ x * 32, y * 32 });
+                scenery_update_tile(x * 32, y * 32);
+            }
+            _idleTiles.set(tileIndex, map_tile_is_idle(x, y, tileElement));
         }
 
         gGrassSceneryTileLoopPosition++;
@@ -1610,6 +1787,8 @@ void map_remove_out_of_range_elements()
                 if (surfaceElement != nullptr)
                 {
                     surfaceElement->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
+                    park_update_size_at({ x, y });
+                    map_invalidate_idle_tile(x / 32, y / 32);
                     update_park_fences_around_tile({ x, y });
                 }
                 clear_elements_at(x, y);
@@ -1666,6 +1845,8 @@ void map_extend_boundary_surface()
         newTileElement->base_height = z;
         newTileElement->clearance_height = z;
 
+        park_update_size_at({ x << 5, y << 5 });
+        map_invalidate_idle_tile(x, y);
         update_park_fences({ x << 5, y << 5 });
     }
 
@@ -1709,6 +1890,8 @@ void map_extend_boundary_surface()
         newTileElement->base_height = z;
         newTileElement->clearance_height = z;
 
+        park_update_size_at({ x << 5, y << 5 });
+        map_invalidate_idle_tile(x, y);
         update_park_fences({ x << 5, y << 5 });
     }
 }
@@ -1802,6 +1985,7 @@ static void clear_elements_at(int32_t x, int32_t y)
 
     // Remove the last element
     clear_element_at(x, y, &tileElement);
+    park_update_size_at({ x, y });
 }
 
 int32_t map_get_highest_z(int32_t tileX, int32_t tileY)
@@ -2414,6 +2598,14 @@ void game_command_modify_tile(
             break;
     }
 
+    if ((flags & GAME_COMMAND_FLAG_APPLY) && *ebx != MONEY32_UNDEFINED)
+    {
+        // The tile inspector can change paths in any way, including their edges.
+        map_queue_path_wide_flags_update(x << 5, y << 5);
+        // Removing or pasting surface elements changes the park size.
+        park_update_size_at({ x << 5, y << 5 });
+    }
+
     if (flags & GAME_COMMAND_FLAG_APPLY && gGameCommandNestLevel == 1 && !(flags & GAME_COMMAND_FLAG_GHOST)
         && *ebx != MONEY32_UNDEFINED)
     {
@@ -2647,6 +2839,7 @@ void FixLandOwnershipTilesWithOwnership(std::initializer_list<TileCoordsXY> tile
     {
         currentElement = map_get_surface_element_at((*tile).x, (*tile).y);
         currentElement->AsSurface()->SetOwnership(ownership);
+        park_update_size_at({ (*tile).x * 32, (*tile).y * 32 });
         update_park_fences_around_tile({ (*tile).x * 32, (*tile).y * 32 });
     }
 }
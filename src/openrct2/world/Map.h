@@ -159,6 +159,8 @@ bool map_coord_is_connected(int32_t x, int32_t y, int32_t z, uint8_t faceDirecti
 void map_remove_provisional_elements();
 void map_restore_provisional_elements();
 void map_update_path_wide_flags();
+void map_queue_path_wide_flags_update(int32_t x, int32_t y);
+void map_reset_path_wide_flags();
 bool map_is_location_valid(CoordsXY coords);
 bool map_is_edge(CoordsXY coords);
 bool map_can_build_at(int32_t x, int32_t y, int32_t z);
@@ -205,6 +207,9 @@ void tile_element_iterator_restart_for_tile(tile_element_iterator* it);
 
 void wall_remove_intersecting_walls(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t direction);
 void map_update_tiles();
+void map_invalidate_idle_tiles();
+void map_invalidate_idle_tile(int32_t x, int32_t y);
+bool map_track_idle_tile_changes(bool enabled);
 int32_t map_get_highest_z(int32_t tileX, int32_t tileY);
 
 bool tile_element_wants_path_connection_towards(TileCoordsXYZD coords, const TileElement* const elementToBeRemoved);
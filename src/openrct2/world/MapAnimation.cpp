@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Game.h"
+#include "../OpenRCT2.h"
 #include "../interface/Viewport.h"
 #include "../object/StationObject.h"
 #include "../ride/Ride.h"
@@ -25,14 +26,33 @@
 #include "SmallScenery.h"
 #include "Sprite.h"
 
-#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
 
 using map_animation_invalidate_event_handler = bool (*)(int32_t x, int32_t y, int32_t baseZ);
 
-static bool map_animation_invalidate(rct_map_animation* obj);
+static bool map_animation_invalidate(const rct_map_animation& obj);
 
-uint16_t gNumMapAnimations;
-rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
+// Animations are kept in buckets of MAP_ANIMATION_CHUNK_SIZE x MAP_ANIMATION_CHUNK_SIZE tiles so that only the
+// buckets that are on screen need to be visited when invalidating.
+constexpr int32_t MAP_ANIMATION_CHUNK_SIZE = 8;
+constexpr int32_t MAP_ANIMATION_CHUNKS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL / MAP_ANIMATION_CHUNK_SIZE;
+
+// Each bucket is sorted by position so that the order animations are updated in only depends on the map.
+static std::vector<rct_map_animation> _mapAnimationChunks[MAP_ANIMATION_CHUNKS_PER_ROW * MAP_ANIMATION_CHUNKS_PER_ROW];
+
+static std::vector<rct_map_animation>& map_animation_get_chunk(int32_t x, int32_t y)
+{
+    int32_t chunkX = std::clamp(x / 32, 0, MAXIMUM_MAP_SIZE_TECHNICAL - 1) / MAP_ANIMATION_CHUNK_SIZE;
+    int32_t chunkY = std::clamp(y / 32, 0, MAXIMUM_MAP_SIZE_TECHNICAL - 1) / MAP_ANIMATION_CHUNK_SIZE;
+    return _mapAnimationChunks[chunkY * MAP_ANIMATION_CHUNKS_PER_ROW + chunkX];
+}
+
+static bool map_animation_less(const rct_map_animation& a, const rct_map_animation& b)
+{
+    return std::make_tuple(a.y, a.x, a.baseZ, a.type) < std::make_tuple(b.y, b.x, b.baseZ, b.type);
+}
 
 /**
  *
@@ -45,33 +65,132 @@ rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
  */
 void map_animation_create(int32_t type, int32_t x, int32_t y, int32_t z)
 {
-    rct_map_animation* aobj = &gAnimatedObjects[0];
-    int32_t numAnimatedObjects = gNumMapAnimations;
-    if (numAnimatedObjects >= MAX_ANIMATED_OBJECTS)
+    rct_map_animation animation;
+    animation.baseZ = z;
+    animation.type = type;
+    animation.x = x;
+    animation.y = y;
+
+    auto& chunk = map_animation_get_chunk(x, y);
+    auto it = std::lower_bound(chunk.begin(), chunk.end(), animation, map_animation_less);
+    if (it != chunk.end() && !map_animation_less(animation, *it))
     {
-        log_error("Exceeded the maximum number of animations");
+        // Animation already exists
         return;
     }
-    for (int32_t i = 0; i < numAnimatedObjects; i++, aobj++)
+    chunk.insert(it, animation);
+}
+
+/**
+ * Whether the animation changes the map or the peeps around it, rather than only redrawing its tile. These have to be
+ * updated whether they are on screen or not, otherwise the game state would depend on what each player is looking at.
+ */
+static bool map_animation_has_side_effects(const rct_map_animation& obj)
+{
+    switch (obj.type)
     {
-        if (aobj->x != x)
-            continue;
-        if (aobj->y != y)
-            continue;
-        if (aobj->baseZ != z)
-            continue;
-        if (aobj->type != type)
-            continue;
-        // Animation already exists
-        return;
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+            // Clocks make the peeps in front of them check the time.
+            return !(gCurrentTicks & 0x3FF);
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
+            return true;
+        default:
+            return false;
     }
+}
 
-    // Create new animation
-    gNumMapAnimations++;
-    aobj->type = type;
-    aobj->x = x;
-    aobj->y = y;
-    aobj->baseZ = z;
+static uint8_t map_animation_get_element_type(const rct_map_animation& obj)
+{
+    switch (obj.type)
+    {
+        case MAP_ANIMATION_TYPE_RIDE_ENTRANCE:
+        case MAP_ANIMATION_TYPE_PARK_ENTRANCE:
+            return TILE_ELEMENT_TYPE_ENTRANCE;
+        case MAP_ANIMATION_TYPE_QUEUE_BANNER:
+            return TILE_ELEMENT_TYPE_PATH;
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+            return TILE_ELEMENT_TYPE_SMALL_SCENERY;
+        case MAP_ANIMATION_TYPE_TRACK_WATERFALL:
+        case MAP_ANIMATION_TYPE_TRACK_RAPIDS:
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL:
+        case MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL:
+            return TILE_ELEMENT_TYPE_TRACK;
+        case MAP_ANIMATION_TYPE_BANNER:
+            return TILE_ELEMENT_TYPE_BANNER;
+        case MAP_ANIMATION_TYPE_LARGE_SCENERY:
+            return TILE_ELEMENT_TYPE_LARGE_SCENERY;
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
+        case MAP_ANIMATION_TYPE_WALL:
+            return TILE_ELEMENT_TYPE_WALL;
+        default:
+            return 0xFF;
+    }
+}
+
+/**
+ * Whether the tile still has an element the animation could belong to. Unlike the invalidate handlers this has no side
+ * effects, so it can be used on animations that are not on screen.
+ */
+static bool map_animation_has_element(const rct_map_animation& obj)
+{
+    uint8_t elementType = map_animation_get_element_type(obj);
+    if (elementType == 0xFF)
+        return false;
+
+    auto tileElement = map_get_first_element_at(obj.x >> 5, obj.y >> 5);
+    if (tileElement == nullptr)
+        return false;
+
+    do
+    {
+        if (tileElement->base_height == obj.baseZ && tileElement->GetType() == elementType)
+            return true;
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+/**
+ * Removes the animations of a chunk whose element has been removed from the map.
+ */
+static void map_animation_purge_chunk(std::vector<rct_map_animation>& chunk)
+{
+    auto isStale = [](const rct_map_animation& animation) { return !map_animation_has_element(animation); };
+    chunk.erase(std::remove_if(chunk.begin(), chunk.end(), isStale), chunk.end());
+}
+
+static bool map_animation_is_chunk_visible(int32_t chunkX, int32_t chunkY)
+{
+    if (gOpenRCT2Headless)
+        return false;
+
+    int32_t x0 = chunkX * MAP_ANIMATION_CHUNK_SIZE * 32;
+    int32_t y0 = chunkY * MAP_ANIMATION_CHUNK_SIZE * 32;
+    int32_t x1 = x0 + MAP_ANIMATION_CHUNK_SIZE * 32;
+    int32_t y1 = y0 + MAP_ANIMATION_CHUNK_SIZE * 32;
+
+    int32_t left, top, right, bottom;
+    map_get_bounding_box(x0, y0, x1, y1, &left, &top, &right, &bottom);
+    left -= 32;
+    right += 32;
+    bottom += 32;
+    top -= 32 + 2080;
+
+    for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
+    {
+        // Animations are only invalidated on viewports zoomed in up to 1.
+        const rct_viewport* viewport = &g_viewport_list[i];
+        if (viewport->width == 0 || viewport->zoom > 1)
+            continue;
+
+        if (right > viewport->view_x && left < viewport->view_x + viewport->view_width && bottom > viewport->view_y
+            && top < viewport->view_y + viewport->view_height)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -80,26 +199,158 @@ void map_animation_create(int32_t type, int32_t x, int32_t y, int32_t z)
  */
 void map_animation_invalidate_all()
 {
-    rct_map_animation* aobj = &gAnimatedObjects[0];
-    int32_t numAnimatedObjects = gNumMapAnimations;
-    while (numAnimatedObjects > 0)
+    for (int32_t chunkY = 0; chunkY < MAP_ANIMATION_CHUNKS_PER_ROW; chunkY++)
     {
-        if (map_animation_invalidate(aobj))
+        for (int32_t chunkX = 0; chunkX < MAP_ANIMATION_CHUNKS_PER_ROW; chunkX++)
         {
-            // Remove animated object
-            gNumMapAnimations--;
-            numAnimatedObjects--;
-            if (numAnimatedObjects > 0)
-                memmove(aobj, aobj + 1, numAnimatedObjects * sizeof(rct_map_animation));
+            auto& chunk = _mapAnimationChunks[chunkY * MAP_ANIMATION_CHUNKS_PER_ROW + chunkX];
+            if (chunk.empty())
+                continue;
+
+            bool visible = map_animation_is_chunk_visible(chunkX, chunkY);
+            size_t numKept = 0;
+            for (size_t i = 0; i < chunk.size(); i++)
+            {
+                const auto animation = chunk[i];
+                if ((!visible && !map_animation_has_side_effects(animation)) || !map_animation_invalidate(animation))
+                {
+                    chunk[numKept++] = animation;
+                }
+            }
+            chunk.resize(numKept);
         }
-        else
+    }
+
+    // Animations that are never on screen, such as all of them on a headless server, are never invalidated, so purge the
+    // ones whose element is gone from one chunk per tick. This only depends on the map, so every player purges the same.
+    map_animation_purge_chunk(_mapAnimationChunks[gCurrentTicks % std::size(_mapAnimationChunks)]);
+}
+
+void map_animation_reset()
+{
+    for (auto& chunk : _mapAnimationChunks)
+    {
+        chunk.clear();
+    }
+}
+
+std::vector<rct_map_animation> map_animation_get_all()
+{
+    // Skip animations whose element is gone and has not been purged yet, they would take up room in saved games.
+    std::vector<rct_map_animation> animations;
+    for (const auto& chunk : _mapAnimationChunks)
+    {
+        std::copy_if(chunk.begin(), chunk.end(), std::back_inserter(animations), map_animation_has_element);
+    }
+    return animations;
+}
+
+static void map_animation_auto_create_at(int32_t x, int32_t y, const TileElement* tileElement)
+{
+    int32_t z = tileElement->base_height;
+    switch (tileElement->GetType())
+    {
+        case TILE_ELEMENT_TYPE_PATH:
+            if (tileElement->AsPath()->IsQueue() && tileElement->AsPath()->HasQueueBanner())
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, x, y, z);
+            }
+            break;
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            switch (tileElement->AsEntrance()->GetEntranceType())
+            {
+                case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                    map_animation_create(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, x, y, z);
+                    break;
+                case ENTRANCE_TYPE_PARK_ENTRANCE:
+                    if (tileElement->AsEntrance()->GetSequenceIndex() == 0)
+                    {
+                        map_animation_create(MAP_ANIMATION_TYPE_PARK_ENTRANCE, x, y, z);
+                    }
+                    break;
+            }
+            break;
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+        {
+            auto sceneryEntry = tileElement->AsSmallScenery()->GetEntry();
+            if (sceneryEntry != nullptr && scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_ANIMATED))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_SMALL_SCENERY, x, y, z);
+            }
+            break;
+        }
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
         {
-            numAnimatedObjects--;
-            aobj++;
+            auto sceneryEntry = tileElement->AsLargeScenery()->GetEntry();
+            if (sceneryEntry != nullptr && (sceneryEntry->large_scenery.flags & LARGE_SCENERY_FLAG_ANIMATED))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_LARGE_SCENERY, x, y, z);
+            }
+            break;
         }
+        case TILE_ELEMENT_TYPE_WALL:
+        {
+            auto sceneryEntry = tileElement->AsWall()->GetEntry();
+            if (sceneryEntry == nullptr)
+                break;
+
+            if ((sceneryEntry->wall.flags2 & WALL_SCENERY_2_ANIMATED)
+                || sceneryEntry->wall.scrolling_mode != SCROLLING_MODE_NONE)
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_WALL, x, y, z);
+            }
+            if ((sceneryEntry->wall.flags & WALL_SCENERY_IS_DOOR) && tileElement->AsWall()->GetAnimationFrame() != 0)
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_WALL_DOOR, x, y, z);
+            }
+            break;
+        }
+        case TILE_ELEMENT_TYPE_BANNER:
+            map_animation_create(MAP_ANIMATION_TYPE_BANNER, x, y, z);
+            break;
+        case TILE_ELEMENT_TYPE_TRACK:
+            switch (tileElement->AsTrack()->GetTrackType())
+            {
+                case TRACK_ELEM_WATERFALL:
+                    map_animation_create(MAP_ANIMATION_TYPE_TRACK_WATERFALL, x, y, z);
+                    break;
+                case TRACK_ELEM_RAPIDS:
+                    map_animation_create(MAP_ANIMATION_TYPE_TRACK_RAPIDS, x, y, z);
+                    break;
+                case TRACK_ELEM_WHIRLPOOL:
+                    map_animation_create(MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL, x, y, z);
+                    break;
+                case TRACK_ELEM_SPINNING_TUNNEL:
+                    map_animation_create(MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL, x, y, z);
+                    break;
+                case TRACK_ELEM_ON_RIDE_PHOTO:
+                    if (tileElement->AsTrack()->IsTakingPhoto())
+                    {
+                        map_animation_create(MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO, x, y, z);
+                    }
+                    break;
+            }
+            break;
     }
 }
 
+/**
+ * Registers the animations of every element on the map. Saved games only have room for a limited number of
+ * animations, so the ones that did not fit are recreated from the map when a park is loaded.
+ */
+void map_animation_auto_create()
+{
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (it.element->IsGhost())
+            continue;
+
+        map_animation_auto_create_at(it.x * 32, it.y * 32, it.element);
+    } while (tile_element_iterator_next(&it));
+}
+
 /**
  *
  *  rct2: 0x00666670
@@ -598,9 +849,9 @@ static constexpr const map_animation_invalidate_event_handler _animatedObjectEve
 /**
  * @returns true if the animation should be removed.
  */
-static bool map_animation_invalidate(rct_map_animation* obj)
+static bool map_animation_invalidate(const rct_map_animation& obj)
 {
-    assert(obj->type < MAP_ANIMATION_TYPE_COUNT);
+    assert(obj.type < MAP_ANIMATION_TYPE_COUNT);
 
-    return _animatedObjectEventHandlers[obj->type](obj->x, obj->y, obj->baseZ);
+    return _animatedObjectEventHandlers[obj.type](obj.x, obj.y, obj.baseZ);
 }
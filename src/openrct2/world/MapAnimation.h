@@ -12,6 +12,8 @@
 
 #include "../common.h"
 
+#include <vector>
+
 #pragma pack(push, 1)
 /**
  * Animated object
@@ -46,12 +48,10 @@ enum
     MAP_ANIMATION_TYPE_COUNT
 };
 
-#define MAX_ANIMATED_OBJECTS 2000
-
-extern uint16_t gNumMapAnimations;
-extern rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
-
 void map_animation_create(int32_t type, int32_t x, int32_t y, int32_t z);
 void map_animation_invalidate_all();
+void map_animation_reset();
+void map_animation_auto_create();
+std::vector<rct_map_animation> map_animation_get_all();
 
 #endif
@@ -17,6 +17,7 @@
 #include "../OpenRCT2.h"
 #include "../actions/ParkSetParameterAction.hpp"
 #include "../config/Config.h"
+#include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
 #include "../interface/Colour.h"
 #include "../interface/Window.h"
@@ -40,6 +41,7 @@
 #include "Surface.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 using namespace OpenRCT2;
@@ -79,6 +81,14 @@ int32_t _suggestedGuestMaximum;
  */
 int32_t _guestGenerationProbability;
 
+/**
+ * The owned surface elements of each tile, which count towards the park size. Kept up to date as land ownership changes
+ * so that the park size does not need a scan of the whole map. A tile normally has a single surface element, but the
+ * tile inspector can paste more and each of them counts, the same as in the full scan.
+ */
+static uint16_t _parkSizeTiles[MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL];
+static int32_t _parkSizeTileCount;
+
 /**
  *
  *  rct2: 0x00667104
@@ -349,7 +359,10 @@ void Park::Update(const Date& date)
     // Every ~102 seconds
     if (gCurrentTicks % 4096 == 0)
     {
-        gParkSize = CalculateParkSize();
+#ifdef DEBUG
+        Guard::Assert(_parkSizeTileCount == CalculateParkSize(), "Park size out of sync with land ownership");
+#endif
+        gParkSize = _parkSizeTileCount;
         window_invalidate_by_class(WC_PARK_INFORMATION);
     }
     // Every new week
@@ -378,12 +391,6 @@ int32_t Park::CalculateParkSize() const
         }
     } while (tile_element_iterator_next(&it));
 
-    if (tiles != gParkSize)
-    {
-        gParkSize = tiles;
-        window_invalidate_by_class(WC_PARK_INFORMATION);
-    }
-
     return tiles;
 }
 
@@ -825,7 +832,8 @@ int32_t park_is_open()
 
 int32_t park_calculate_size()
 {
-    auto tiles = GetContext()->GetGameState()->GetPark().CalculateParkSize();
+    park_reset_size_tiles();
+    auto tiles = _parkSizeTileCount;
     if (tiles != gParkSize)
     {
         gParkSize = tiles;
@@ -834,6 +842,46 @@ int32_t park_calculate_size()
     return tiles;
 }
 
+void park_update_size_at(CoordsXY coords)
+{
+    if (coords.x < 0 || coords.y < 0 || coords.x >= MAXIMUM_MAP_SIZE_TECHNICAL * 32
+        || coords.y >= MAXIMUM_MAP_SIZE_TECHNICAL * 32)
+    {
+        return;
+    }
+
+    uint16_t counted = 0;
+    TileElement* tileElement = map_get_first_element_at(coords.x / 32, coords.y / 32);
+    if (tileElement != nullptr)
+    {
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_SURFACE
+                && (tileElement->AsSurface()->GetOwnership() & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED)))
+            {
+                counted++;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+
+    size_t index = (coords.y / 32) * MAXIMUM_MAP_SIZE_TECHNICAL + (coords.x / 32);
+    _parkSizeTileCount += counted - _parkSizeTiles[index];
+    _parkSizeTiles[index] = counted;
+}
+
+void park_reset_size_tiles()
+{
+    std::fill_n(_parkSizeTiles, std::size(_parkSizeTiles), 0);
+    _parkSizeTileCount = 0;
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            park_update_size_at({ x * 32, y * 32 });
+        }
+    }
+}
+
 uint8_t calculate_guest_initial_happiness(uint8_t percentage)
 {
     return Park::CalculateGuestInitialHappiness(percentage);
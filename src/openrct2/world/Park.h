@@ -40,6 +40,7 @@ enum : uint32_t
     PARK_FLAGS_NO_MONEY_SCENARIO = (1 << 17),                 // equivalent to PARK_FLAGS_NO_MONEY, but used in scenario editor
     PARK_FLAGS_SPRITES_INITIALISED = (1 << 18),  // After a scenario is loaded this prevents edits in the scenario editor
     PARK_FLAGS_SIX_FLAGS_DEPRECATED = (1 << 19), // Not used anymore
+    PARK_FLAGS_PATH_WIDE_FLAGS_ON_CHANGE = (1 << 30), // OpenRCT2 only! Wide paths are updated around path changes only
     PARK_FLAGS_UNLOCK_ALL_PRICES = (1u << 31),   // OpenRCT2 only!
 };
 
@@ -113,6 +114,8 @@ int32_t get_forced_park_rating();
 
 int32_t park_is_open();
 int32_t park_calculate_size();
+void park_update_size_at(CoordsXY coords);
+void park_reset_size_tiles();
 
 void reset_park_entry();
 
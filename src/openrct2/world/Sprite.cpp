@@ -18,12 +18,16 @@
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../peep/Staff.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
+#include "Map.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <set>
+#include <vector>
 
 uint16_t gSpriteListHead[6];
 uint16_t gSpriteListCount[6];
@@ -51,7 +55,64 @@ const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
 static LocationXYZ16 _spritelocations1[MAX_SPRITES];
 static LocationXYZ16 _spritelocations2[MAX_SPRITES];
 
+#define LITTER_TILE_NULL 0xFFFFFFFF
+
+struct LitterAge
+{
+    uint32_t CreationTick;
+    uint32_t Sequence;
+    uint16_t SpriteIndex;
+
+    // Orders the litter the way litter_create used to pick it from the litter list: the newest litter comes last and
+    // of the litter created in the same tick, the one that was added first.
+    bool operator<(const LitterAge& other) const
+    {
+        if (CreationTick != other.CreationTick)
+        {
+            return CreationTick < other.CreationTick;
+        }
+        return Sequence > other.Sequence;
+    }
+};
+
+// Litter by tile, so that handymen only have to look at the litter around them.
+static uint16_t _litterTileIndex[MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL];
+static uint16_t _litterNextInTile[MAX_SPRITES];
+static uint32_t _litterTile[MAX_SPRITES];
+// Increases with every litter added to the litter list, litter that was added later comes first in the list.
+static uint32_t _litterSequence[MAX_SPRITES];
+static bool _litterIndexed[MAX_SPRITES];
+static uint32_t _litterNextSequence;
+static std::set<LitterAge> _litterByAge;
+
+// Dense copies of the sprite lists walked every tick, so the update loops read an array instead of following the links
+// through the sprite array. Sprites are appended when they enter the list, the way they become its head, so the array
+// is in reverse list order. Removed sprites leave SPRITE_INDEX_NULL behind until sprite_list_get_dense compacts it.
+struct SpriteListDense
+{
+    std::vector<uint16_t> Entries;
+    size_t NumRemoved = 0;
+};
+static SpriteListDense _spriteListDense[NUM_SPRITE_LISTS];
+static uint32_t _spriteListDenseSlot[MAX_SPRITES];
+
+// The locations of the sprites on each tile as a contiguous array, so spatial queries do not have to follow the
+// next_in_quadrant links through the sprite array. A sprite entering a tile becomes the head of its quadrant list and is
+// appended here, so each bucket is in reverse next_in_quadrant order. Sprites without a location are not kept.
+struct SpriteSpatialBuckets
+{
+    std::vector<SpriteSpatialEntry> Tiles[SPATIAL_INDEX_LOCATION_NULL];
+    uint32_t Bucket[MAX_SPRITES];
+    uint32_t Slot[MAX_SPRITES];
+};
+static SpriteSpatialBuckets _spriteSpatialBuckets;
+// The same for vehicles only, so collision checks do not have to skip the peeps and litter sharing their tiles.
+static SpriteSpatialBuckets _vehicleSpatialBuckets;
+
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
+static void litter_index_add(rct_litter* litter);
+static void litter_index_remove(rct_litter* litter);
+static void litter_index_move(rct_litter* litter);
 
 std::string rct_sprite_checksum::ToString() const
 {
@@ -94,6 +155,52 @@ uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
     return gSpriteSpatialIndex[offset];
 }
 
+/**
+ * Returns the locations of the sprites on the tile at the given location, in reverse next_in_quadrant order. Sprites
+ * must not be moved or removed while walking the bucket.
+ */
+const std::vector<SpriteSpatialEntry>& sprite_get_tile_bucket(int32_t x, int32_t y)
+{
+    int32_t offset = ((x & 0x1FE0) << 3) | (y >> 5);
+    return _spriteSpatialBuckets.Tiles[offset];
+}
+
+/**
+ * Returns the locations of the vehicles on the tile at the given location, in reverse next_in_quadrant order. Vehicles
+ * must not be moved or removed while walking the bucket.
+ */
+const std::vector<SpriteSpatialEntry>& sprite_get_tile_vehicle_bucket(int32_t x, int32_t y)
+{
+    int32_t offset = ((x & 0x1FE0) << 3) | (y >> 5);
+    return _vehicleSpatialBuckets.Tiles[offset];
+}
+
+/**
+ * Collects the sprites that are no further than range from the given location on either axis, tile by tile and in
+ * next_in_quadrant order within each tile.
+ */
+void sprite_get_in_range(int32_t x, int32_t y, int32_t range, std::vector<uint16_t>& result)
+{
+    int32_t minX = std::max(x - range, 0);
+    int32_t minY = std::max(y - range, 0);
+    int32_t maxX = std::min(x + range, 0x1FFF);
+    int32_t maxY = std::min(y + range, 0x1FFF);
+    for (int32_t tileX = floor2(minX, 32); tileX <= maxX; tileX += 32)
+    {
+        for (int32_t tileY = floor2(minY, 32); tileY <= maxY; tileY += 32)
+        {
+            const auto& bucket = sprite_get_tile_bucket(tileX, tileY);
+            for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
+            {
+                if (it->x >= minX && it->x <= maxX && it->y >= minY && it->y <= maxY)
+                {
+                    result.push_back(it->SpriteIndex);
+                }
+            }
+        }
+    }
+}
+
 static void invalidate_sprite_max_zoom(rct_sprite* sprite, int32_t maxZoom)
 {
     if (sprite->generic.sprite_left == LOCATION_NULL)
@@ -205,6 +312,201 @@ void reset_sprite_spatial_index()
             spr->generic.next_in_quadrant = nextSpriteId;
         }
     }
+    reset_sprite_spatial_buckets();
+    reset_sprite_list_indices();
+}
+
+static bool sprite_list_is_dense(int32_t list)
+{
+    return list == SPRITE_LIST_TRAIN || list == SPRITE_LIST_PEEP;
+}
+
+static void sprite_list_dense_add(int32_t list, uint16_t spriteIndex)
+{
+    if (sprite_list_is_dense(list))
+    {
+        auto& dense = _spriteListDense[list];
+        _spriteListDenseSlot[spriteIndex] = (uint32_t)dense.Entries.size();
+        dense.Entries.push_back(spriteIndex);
+    }
+}
+
+static void sprite_list_dense_remove(int32_t list, uint16_t spriteIndex)
+{
+    if (sprite_list_is_dense(list))
+    {
+        auto& dense = _spriteListDense[list];
+        uint32_t slot = _spriteListDenseSlot[spriteIndex];
+        if (slot < dense.Entries.size() && dense.Entries[slot] == spriteIndex)
+        {
+            dense.Entries[slot] = SPRITE_INDEX_NULL;
+            dense.NumRemoved++;
+        }
+    }
+}
+
+static void sprite_list_dense_reset(int32_t list)
+{
+    auto& dense = _spriteListDense[list];
+    dense.Entries.clear();
+    dense.NumRemoved = 0;
+    if (!sprite_list_is_dense(list))
+    {
+        return;
+    }
+
+    std::vector<uint16_t> entries;
+    uint16_t spriteIndex = gSpriteListHead[list];
+    while (spriteIndex != SPRITE_INDEX_NULL && entries.size() < MAX_SPRITES)
+    {
+        entries.push_back(spriteIndex);
+        spriteIndex = get_sprite(spriteIndex)->generic.next;
+    }
+    for (auto it = entries.rbegin(); it != entries.rend(); it++)
+    {
+        sprite_list_dense_add(list, *it);
+    }
+}
+
+/**
+ * Returns the sprites of a list in reverse list order, removed sprites are SPRITE_INDEX_NULL. The array is only
+ * compacted here, so it can be walked by index while sprites enter and leave the list; sprites that enter are appended.
+ */
+const std::vector<uint16_t>& sprite_list_get_dense(SPRITE_LIST list)
+{
+    auto& dense = _spriteListDense[list];
+    if (dense.NumRemoved != 0)
+    {
+        dense.Entries.erase(std::remove(dense.Entries.begin(), dense.Entries.end(), SPRITE_INDEX_NULL), dense.Entries.end());
+        dense.NumRemoved = 0;
+        for (size_t i = 0; i < dense.Entries.size(); i++)
+        {
+            _spriteListDenseSlot[dense.Entries[i]] = (uint32_t)i;
+        }
+    }
+    return dense.Entries;
+}
+
+/**
+ * Rebuilds everything derived from the sprite lists, for when they have been written directly rather than through
+ * move_sprite_to_list.
+ */
+void reset_sprite_list_indices()
+{
+    for (int32_t list = 0; list < NUM_SPRITE_LISTS; list++)
+    {
+        sprite_list_dense_reset(list);
+    }
+
+    litter_index_reset();
+    staff_index_reset();
+}
+
+/**
+ * Rebuilds everything that follows the order of a sprite list, for when its sprites have been relinked in place.
+ */
+void reset_sprite_list_order(SPRITE_LIST list)
+{
+    sprite_list_dense_reset(list);
+    if (list == SPRITE_LIST_PEEP)
+    {
+        staff_index_reset();
+    }
+}
+
+static void sprite_spatial_bucket_add(SpriteSpatialBuckets& buckets, rct_sprite* sprite, size_t bucket)
+{
+    uint16_t spriteIndex = sprite->generic.sprite_index;
+    buckets.Bucket[spriteIndex] = (uint32_t)bucket;
+    if (bucket != SPATIAL_INDEX_LOCATION_NULL)
+    {
+        auto& entries = buckets.Tiles[bucket];
+        buckets.Slot[spriteIndex] = (uint32_t)entries.size();
+        entries.push_back({ spriteIndex, sprite->generic.x, sprite->generic.y, sprite->generic.z });
+    }
+}
+
+static void sprite_spatial_bucket_remove(SpriteSpatialBuckets& buckets, rct_sprite* sprite)
+{
+    uint16_t spriteIndex = sprite->generic.sprite_index;
+    uint32_t bucket = buckets.Bucket[spriteIndex];
+    buckets.Bucket[spriteIndex] = SPATIAL_INDEX_LOCATION_NULL;
+    if (bucket >= SPATIAL_INDEX_LOCATION_NULL)
+    {
+        return;
+    }
+
+    auto& entries = buckets.Tiles[bucket];
+    uint32_t slot = buckets.Slot[spriteIndex];
+    if (slot < entries.size() && entries[slot].SpriteIndex == spriteIndex)
+    {
+        entries.erase(entries.begin() + slot);
+        for (size_t i = slot; i < entries.size(); i++)
+        {
+            buckets.Slot[entries[i].SpriteIndex] = (uint32_t)i;
+        }
+    }
+}
+
+/**
+ * Moves the sprite to the end of the bucket when it has been relinked as the head of a quadrant list, otherwise only
+ * updates its location.
+ */
+static void sprite_spatial_bucket_move(SpriteSpatialBuckets& buckets, rct_sprite* sprite, size_t bucket, bool relinked)
+{
+    uint16_t spriteIndex = sprite->generic.sprite_index;
+    if (relinked || buckets.Bucket[spriteIndex] != bucket)
+    {
+        sprite_spatial_bucket_remove(buckets, sprite);
+        sprite_spatial_bucket_add(buckets, sprite, bucket);
+    }
+    else if (bucket != SPATIAL_INDEX_LOCATION_NULL)
+    {
+        auto& entry = buckets.Tiles[bucket][buckets.Slot[spriteIndex]];
+        entry.x = sprite->generic.x;
+        entry.y = sprite->generic.y;
+        entry.z = sprite->generic.z;
+    }
+}
+
+static void sprite_spatial_buckets_clear(SpriteSpatialBuckets& buckets)
+{
+    for (auto& entries : buckets.Tiles)
+    {
+        entries.clear();
+    }
+    std::fill_n(buckets.Bucket, std::size(buckets.Bucket), SPATIAL_INDEX_LOCATION_NULL);
+}
+
+/**
+ * Rebuilds the tile buckets from the quadrant lists, for when they have been written directly rather than through
+ * sprite_move.
+ */
+void reset_sprite_spatial_buckets()
+{
+    sprite_spatial_buckets_clear(_spriteSpatialBuckets);
+    sprite_spatial_buckets_clear(_vehicleSpatialBuckets);
+
+    std::vector<rct_sprite*> sprites;
+    for (size_t bucket = 0; bucket < SPATIAL_INDEX_LOCATION_NULL; bucket++)
+    {
+        sprites.clear();
+        uint16_t spriteIndex = gSpriteSpatialIndex[bucket];
+        while (spriteIndex < MAX_SPRITES && sprites.size() < MAX_SPRITES)
+        {
+            rct_sprite* sprite = get_sprite(spriteIndex);
+            sprites.push_back(sprite);
+            spriteIndex = sprite->generic.next_in_quadrant;
+        }
+        for (auto it = sprites.rbegin(); it != sprites.rend(); it++)
+        {
+            sprite_spatial_bucket_add(_spriteSpatialBuckets, *it, bucket);
+            if ((*it)->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+            {
+                sprite_spatial_bucket_add(_vehicleSpatialBuckets, *it, bucket);
+            }
+        }
+    }
 }
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
@@ -423,6 +725,9 @@ void move_sprite_to_list(rct_sprite* sprite, SPRITE_LIST newList)
         get_sprite(unkSprite->next)->generic.previous = unkSprite->previous;
     }
 
+    sprite_list_dense_remove(oldList, unkSprite->sprite_index);
+    sprite_list_dense_add(newList, unkSprite->sprite_index);
+
     unkSprite->previous = SPRITE_INDEX_NULL; // We become the new head of the target list, so there's no previous sprite
     unkSprite->linked_list_type_offset = newListOffset;
 
@@ -638,6 +943,17 @@ void sprite_move(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
     {
         sprite_set_coordinates(x, y, z, sprite);
     }
+
+    sprite_spatial_bucket_move(_spriteSpatialBuckets, sprite, newIndex, newIndex != currentIndex);
+    if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+    {
+        sprite_spatial_bucket_move(_vehicleSpatialBuckets, sprite, newIndex, newIndex != currentIndex);
+    }
+
+    if (newIndex != currentIndex && sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+    {
+        litter_index_move(&sprite->litter);
+    }
 }
 
 void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
@@ -664,11 +980,22 @@ void sprite_remove(rct_sprite* sprite)
     if (peep != nullptr)
     {
         user_string_free(peep->name_string_idx);
+        if (peep->type == PEEP_TYPE_STAFF)
+        {
+            staff_index_remove(peep);
+        }
+    }
+
+    if (sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+    {
+        litter_index_remove(&sprite->litter);
     }
 
     move_sprite_to_list(sprite, SPRITE_LIST_FREE);
     sprite->generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->generic.sprite_index] = false;
+    sprite_spatial_bucket_remove(_spriteSpatialBuckets, sprite);
+    sprite_spatial_bucket_remove(_vehicleSpatialBuckets, sprite);
 
     size_t quadrantIndex = GetSpatialIndexOffset(sprite->generic.x, sprite->generic.y);
     uint16_t* spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
@@ -717,27 +1044,11 @@ void litter_create(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t t
     if (!litter_can_be_at(x, y, z))
         return;
 
-    if (gSpriteListCount[SPRITE_LIST_LITTER] >= 500)
+    if (gSpriteListCount[SPRITE_LIST_LITTER] >= 500 && !_litterByAge.empty())
     {
-        rct_litter* newestLitter = nullptr;
-        uint32_t newestLitterCreationTick = 0;
-        for (uint16_t nextSpriteIndex, spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
-             spriteIndex = nextSpriteIndex)
-        {
-            rct_litter* litter = &get_sprite(spriteIndex)->litter;
-            nextSpriteIndex = litter->next;
-            if (newestLitterCreationTick <= litter->creationTick)
-            {
-                newestLitterCreationTick = litter->creationTick;
-                newestLitter = litter;
-            }
-        }
-
-        if (newestLitter != nullptr)
-        {
-            invalidate_sprite_0((rct_sprite*)newestLitter);
-            sprite_remove((rct_sprite*)newestLitter);
-        }
+        rct_sprite* newestLitter = get_sprite(_litterByAge.rbegin()->SpriteIndex);
+        invalidate_sprite_0(newestLitter);
+        sprite_remove(newestLitter);
     }
 
     rct_litter* litter = (rct_litter*)create_sprite(1);
@@ -754,6 +1065,142 @@ void litter_create(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t t
     sprite_move(x, y, z, (rct_sprite*)litter);
     invalidate_sprite_0((rct_sprite*)litter);
     litter->creationTick = gScenarioTicks;
+    litter_index_add(litter);
+}
+
+static void litter_index_link_tile(rct_litter* litter)
+{
+    uint16_t spriteIndex = litter->sprite_index;
+    _litterTile[spriteIndex] = LITTER_TILE_NULL;
+    _litterNextInTile[spriteIndex] = SPRITE_INDEX_NULL;
+    if (litter->x != LOCATION_NULL)
+    {
+        uint32_t tile = (litter->x >> 5) + (litter->y >> 5) * MAXIMUM_MAP_SIZE_TECHNICAL;
+        _litterTile[spriteIndex] = tile;
+        _litterNextInTile[spriteIndex] = _litterTileIndex[tile];
+        _litterTileIndex[tile] = spriteIndex;
+    }
+}
+
+static void litter_index_unlink_tile(rct_litter* litter)
+{
+    uint16_t spriteIndex = litter->sprite_index;
+    if (_litterTile[spriteIndex] == LITTER_TILE_NULL)
+    {
+        return;
+    }
+
+    uint16_t* nextIndex = &_litterTileIndex[_litterTile[spriteIndex]];
+    while (*nextIndex != SPRITE_INDEX_NULL && *nextIndex != spriteIndex)
+    {
+        nextIndex = &_litterNextInTile[*nextIndex];
+    }
+    if (*nextIndex == spriteIndex)
+    {
+        *nextIndex = _litterNextInTile[spriteIndex];
+    }
+    _litterTile[spriteIndex] = LITTER_TILE_NULL;
+}
+
+static void litter_index_add(rct_litter* litter)
+{
+    uint16_t spriteIndex = litter->sprite_index;
+    if (_litterIndexed[spriteIndex])
+    {
+        litter_index_remove(litter);
+    }
+
+    _litterIndexed[spriteIndex] = true;
+    _litterSequence[spriteIndex] = _litterNextSequence++;
+    _litterByAge.insert({ litter->creationTick, _litterSequence[spriteIndex], spriteIndex });
+    litter_index_link_tile(litter);
+}
+
+static void litter_index_remove(rct_litter* litter)
+{
+    uint16_t spriteIndex = litter->sprite_index;
+    if (!_litterIndexed[spriteIndex])
+    {
+        return;
+    }
+
+    _litterIndexed[spriteIndex] = false;
+    _litterByAge.erase({ litter->creationTick, _litterSequence[spriteIndex], spriteIndex });
+    litter_index_unlink_tile(litter);
+}
+
+static void litter_index_move(rct_litter* litter)
+{
+    if (_litterIndexed[litter->sprite_index])
+    {
+        litter_index_unlink_tile(litter);
+        litter_index_link_tile(litter);
+    }
+}
+
+/**
+ * Rebuilds the litter index from the litter list, for when sprites have been loaded without going through
+ * litter_create.
+ */
+void litter_index_reset()
+{
+    std::fill_n(_litterTileIndex, std::size(_litterTileIndex), SPRITE_INDEX_NULL);
+    std::fill_n(_litterIndexed, std::size(_litterIndexed), false);
+    _litterByAge.clear();
+    _litterNextSequence = 0;
+
+    std::vector<rct_litter*> litterList;
+    uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER];
+    while (spriteIndex != SPRITE_INDEX_NULL && litterList.size() < MAX_SPRITES)
+    {
+        litterList.push_back(&get_sprite(spriteIndex)->litter);
+        spriteIndex = litterList.back()->next;
+    }
+
+    // The head of the list is the litter added last.
+    for (auto it = litterList.rbegin(); it != litterList.rend(); it++)
+    {
+        litter_index_add(*it);
+    }
+}
+
+/**
+ * Finds the litter closest to the given location, measured as x + y + 4 * z distance. Of litter at the same distance,
+ * the one that comes first in the litter list is returned.
+ *  @returns nullptr if there is no litter within maxDistance.
+ */
+rct_litter* litter_get_nearest(int32_t x, int32_t y, int32_t z, int32_t maxDistance)
+{
+    int32_t minTileX = std::max(x - maxDistance, 0) >> 5;
+    int32_t minTileY = std::max(y - maxDistance, 0) >> 5;
+    int32_t maxTileX = std::min((x + maxDistance) >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    int32_t maxTileY = std::min((y + maxDistance) >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+
+    rct_litter* nearestLitter = nullptr;
+    int32_t nearestLitterDist = maxDistance;
+    for (int32_t tileY = minTileY; tileY <= maxTileY; tileY++)
+    {
+        for (int32_t tileX = minTileX; tileX <= maxTileX; tileX++)
+        {
+            uint16_t spriteIndex = _litterTileIndex[tileX + tileY * MAXIMUM_MAP_SIZE_TECHNICAL];
+            for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = _litterNextInTile[spriteIndex])
+            {
+                rct_litter* litter = &get_sprite(spriteIndex)->litter;
+                int32_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+                if (distance > nearestLitterDist)
+                {
+                    continue;
+                }
+                if (nearestLitter == nullptr || distance < nearestLitterDist
+                    || _litterSequence[spriteIndex] > _litterSequence[nearestLitter->sprite_index])
+                {
+                    nearestLitterDist = distance;
+                    nearestLitter = litter;
+                }
+            }
+        }
+    }
+    return nearestLitter;
 }
 
 /**
@@ -762,25 +1209,25 @@ void litter_create(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t t
  */
 void litter_remove_at(int32_t x, int32_t y, int32_t z)
 {
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    // Collect the litter first, removing it changes the bucket.
+    std::vector<rct_sprite*> litter;
+    const auto& bucket = sprite_get_tile_bucket(x, y);
+    for (auto it = bucket.rbegin(); it != bucket.rend(); it++)
     {
-        rct_sprite* sprite = get_sprite(spriteIndex);
-        uint16_t nextSpriteIndex = sprite->generic.next_in_quadrant;
-        if (sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+        if (abs(it->z - z) <= 16 && abs(it->x - x) <= 8 && abs(it->y - y) <= 8)
         {
-            rct_litter* litter = &sprite->litter;
-
-            if (abs(litter->z - z) <= 16)
+            rct_sprite* sprite = get_sprite(it->SpriteIndex);
+            if (sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
             {
-                if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8)
-                {
-                    invalidate_sprite_0(sprite);
-                    sprite_remove(sprite);
-                }
+                litter.push_back(sprite);
             }
         }
-        spriteIndex = nextSpriteIndex;
+    }
+
+    for (auto sprite : litter)
+    {
+        invalidate_sprite_0(sprite);
+        sprite_remove(sprite);
     }
 }
 
@@ -15,6 +15,8 @@
 #include "../ride/Vehicle.h"
 #include "SpriteBase.h"
 
+#include <vector>
+
 #define SPRITE_INDEX_NULL 0xFFFF
 #define MAX_SPRITES 10000
 #define NUM_SPRITE_LISTS 6
@@ -208,9 +210,21 @@ extern uint16_t gSpriteSpatialIndex[0x10001];
 
 extern const rct_string_id litterNames[12];
 
+struct SpriteSpatialEntry
+{
+    uint16_t SpriteIndex;
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
 rct_sprite* create_sprite(uint8_t bl);
 void reset_sprite_list();
 void reset_sprite_spatial_index();
+void reset_sprite_list_indices();
+void reset_sprite_list_order(SPRITE_LIST list);
+void reset_sprite_spatial_buckets();
+const std::vector<uint16_t>& sprite_list_get_dense(SPRITE_LIST list);
 void sprite_clear_all_unused();
 void move_sprite_to_list(rct_sprite* sprite, SPRITE_LIST newList);
 void sprite_misc_update_all();
@@ -222,9 +236,14 @@ void invalidate_sprite_2(rct_sprite* sprite);
 void sprite_remove(rct_sprite* sprite);
 void litter_create(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t type);
 void litter_remove_at(int32_t x, int32_t y, int32_t z);
+void litter_index_reset();
+rct_litter* litter_get_nearest(int32_t x, int32_t y, int32_t z, int32_t maxDistance);
 void sprite_misc_explosion_cloud_create(int32_t x, int32_t y, int32_t z);
 void sprite_misc_explosion_flare_create(int32_t x, int32_t y, int32_t z);
 uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y);
+const std::vector<SpriteSpatialEntry>& sprite_get_tile_bucket(int32_t x, int32_t y);
+const std::vector<SpriteSpatialEntry>& sprite_get_tile_vehicle_bucket(int32_t x, int32_t y);
+void sprite_get_in_range(int32_t x, int32_t y, int32_t range, std::vector<uint16_t>& result);
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
@@ -202,6 +202,44 @@ void SurfaceElement::UpdateGrassLength(CoordsXY coords)
     }
 }
 
+/**
+ * Whether UpdateGrassLength leaves the grass as it is until the map around it changes: it cannot grow, or it is
+ * cleared and kept that way by water, the park boundary or something on top of it.
+ */
+bool SurfaceElement::IsGrassIdle(CoordsXY coords) const
+{
+    if (!CanGrassGrow())
+        return true;
+
+    if ((grass_length & 7) != GRASS_LENGTH_CLEAR_0)
+        return false;
+
+    uint32_t waterHeight = GetWaterHeight() * 2;
+    if (waterHeight > base_height || !map_is_location_in_park(coords))
+        return true;
+
+    int32_t z0 = base_height;
+    int32_t z1 = base_height + 2;
+    if (slope & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT)
+        z1 += 2;
+
+    const TileElement* tileElementAbove = (const TileElement*)this;
+    while (!tileElementAbove->IsLastForTile())
+    {
+        tileElementAbove++;
+        if (tileElementAbove->GetType() == TILE_ELEMENT_TYPE_WALL)
+            continue;
+        if (tileElementAbove->IsGhost())
+            continue;
+        if (z0 >= tileElementAbove->clearance_height)
+            continue;
+        if (z1 < tileElementAbove->base_height)
+            continue;
+        return true;
+    }
+    return false;
+}
+
 uint8_t SurfaceElement::GetOwnership() const
 {
     return (ownership & TILE_ELEMENT_SURFACE_OWNERSHIP_MASK);
@@ -151,6 +151,7 @@ public:
     void SetGrassLength(uint8_t newLength);
     void SetGrassLengthAndInvalidate(uint8_t newLength, CoordsXY coords);
     void UpdateGrassLength(CoordsXY coords);
+    bool IsGrassIdle(CoordsXY coords) const;
 
     uint8_t GetOwnership() const;
     void SetOwnership(uint8_t newOwnership);
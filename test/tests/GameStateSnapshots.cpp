@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameStateSnapshots.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/world/Sprite.h>
+#include <string>
+
+using namespace OpenRCT2;
+
+class GameStateSnapshotsTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+    static size_t CountChanges(const GameStateCompareData_t& cmpData, uint8_t changeType)
+    {
+        size_t count = 0;
+        for (const auto& change : cmpData.spriteChanges)
+        {
+            if (change.changeType == changeType)
+                count++;
+        }
+        return count;
+    }
+
+    static const GameStateSpriteChange_t* FindChange(const GameStateCompareData_t& cmpData, uint32_t spriteIndex)
+    {
+        for (const auto& change : cmpData.spriteChanges)
+        {
+            if (change.spriteIndex == spriteIndex)
+                return &change;
+        }
+        return nullptr;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> GameStateSnapshotsTest::_context;
+
+TEST_F(GameStateSnapshotsTest, rebuild_deltas)
+{
+    auto snapshots = CreateGameStateSnapshots();
+
+    auto& before = snapshots->CreateSnapshot();
+    snapshots->Capture(before);
+    snapshots->LinkSnapshot(before, 1, 0);
+
+    rct_sprite* sprite = create_sprite(SPRITE_IDENTIFIER_LITTER);
+    ASSERT_NE(sprite, nullptr);
+    sprite->generic.sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+    sprite_move(32 * 10, 32 * 10, 112, sprite);
+    uint32_t spriteIndex = sprite->generic.sprite_index;
+
+    auto& added = snapshots->CreateSnapshot();
+    snapshots->Capture(added);
+    snapshots->LinkSnapshot(added, 2, 0);
+
+    sprite_move(32 * 11, 32 * 10, 112, sprite);
+
+    auto& moved = snapshots->CreateSnapshot();
+    snapshots->Capture(moved);
+    snapshots->LinkSnapshot(moved, 3, 0);
+
+    ASSERT_EQ(snapshots->GetLinkedSnapshot(2), &added);
+
+    // Each snapshot only stores its changes, comparing them rebuilds the full sprite lists.
+    auto cmpAdded = snapshots->Compare(before, added);
+    ASSERT_EQ(cmpAdded.spriteChanges.size(), (size_t)MAX_SPRITES);
+    ASSERT_EQ(CountChanges(cmpAdded, GameStateSpriteChange_t::ADDED), 1u);
+    ASSERT_EQ(FindChange(cmpAdded, spriteIndex)->changeType, GameStateSpriteChange_t::ADDED);
+
+    auto cmpMoved = snapshots->Compare(added, moved);
+    auto change = FindChange(cmpMoved, spriteIndex);
+    ASSERT_EQ(change->changeType, GameStateSpriteChange_t::MODIFIED);
+    auto diff = std::find_if(change->diffs.begin(), change->diffs.end(), [](const GameStateSpriteChange_t::Diff_t& d) {
+        return std::string(d.fieldname) == "x";
+    });
+    ASSERT_NE(diff, change->diffs.end());
+    ASSERT_EQ(diff->valueA, 32u * 10);
+    ASSERT_EQ(diff->valueB, 32u * 11);
+
+    auto cmpSame = snapshots->Compare(moved, moved);
+    ASSERT_EQ(CountChanges(cmpSame, GameStateSpriteChange_t::EQUAL), (size_t)MAX_SPRITES);
+
+    // A snapshot received over the network is rebuilt from the full sprite list.
+    MemoryStream stream;
+    DataSerialiser saver(true, stream);
+    snapshots->SerialiseSnapshot(moved, saver);
+
+    auto& received = snapshots->CreateSnapshot();
+    stream.SetPosition(0);
+    DataSerialiser loader(false, stream);
+    snapshots->SerialiseSnapshot(received, loader);
+
+    auto cmpReceived = snapshots->Compare(moved, received);
+    ASSERT_EQ(CountChanges(cmpReceived, GameStateSpriteChange_t::EQUAL), (size_t)MAX_SPRITES);
+
+    sprite_remove(sprite);
+}
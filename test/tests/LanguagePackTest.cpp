@@ -12,6 +12,8 @@
 #include "openrct2/localisation/Language.h"
 #include "openrct2/localisation/StringIds.h"
 
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 
 #ifndef _WIN32
@@ -77,6 +79,35 @@ TEST_F(LanguagePackTest, language_pack_multibyte)
     delete lang;
 }
 
+TEST_F(LanguagePackTest, language_pack_compiled)
+{
+    const utf8* path = "test_language_pack.txt";
+    const utf8* compiledPath = "test_language_pack.dat";
+    std::remove(compiledPath);
+    {
+        std::ofstream fs(path, std::ios::binary);
+        fs << LanguageEnGB;
+    }
+
+    // First load parses the text and writes the compiled form, the second load reads it back.
+    for (int32_t i = 0; i < 2; i++)
+    {
+        ILanguagePack* lang = LanguagePackFactory::FromFile(0, path, compiledPath);
+        ASSERT_NE(lang, nullptr);
+        ASSERT_EQ(lang->GetCount(), 4U);
+        ASSERT_STREQ(lang->GetString(2), "Spiral Roller Coaster");
+        ASSERT_EQ(lang->GetScenarioOverrideStringId("arid heights", 0), 0x7000);
+        ASSERT_STREQ(lang->GetString(0x7000), "Arid Heights scenario string");
+        ASSERT_EQ(lang->GetObjectOverrideStringId("CONDORRD", 0), 0x6000);
+        ASSERT_STREQ(lang->GetString(0x6000), "my test ride");
+        ASSERT_STREQ(lang->GetString(lang->GetObjectOverrideStringId("CONDORRD", 1)), "ride description");
+        delete lang;
+    }
+
+    std::remove(path);
+    std::remove(compiledPath);
+}
+
 const utf8* LanguagePackTest::LanguageEnGB = "# STR_XXXX part is read and XXXX becomes the string id number.\n"
                                              "# Everything after the colon and before the new line will be saved as the "
                                              "string.\n"
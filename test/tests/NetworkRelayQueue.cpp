@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include <gtest/gtest.h>
+#    include <memory>
+#    include <openrct2/network/NetworkRelayQueue.h>
+#    include <openrct2/network/NetworkTickBatch.h>
+#    include <openrct2/network/NetworkTypes.h>
+#    include <vector>
+
+static std::unique_ptr<NetworkPacket> CreatePacket(uint32_t command, uint32_t tick)
+{
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << command << tick;
+    return packet;
+}
+
+static void ExpectPop(NetworkRelayQueue& queue, uint32_t currentTick, const NetworkPacket& packet, uint32_t tick)
+{
+    NetworkRelayPacket relayPacket;
+    ASSERT_TRUE(queue.Pop(currentTick, relayPacket));
+    ASSERT_TRUE(relayPacket.Timed);
+    ASSERT_EQ(relayPacket.Tick, tick);
+
+    // The spectators receive the packet exactly as the server sent it.
+    NetworkPacketPayload expected(packet);
+    ASSERT_EQ(relayPacket.Payload->GetCommand(), packet.GetCommand());
+    ASSERT_EQ(
+        std::vector<uint8_t>(relayPacket.Payload->GetData(), relayPacket.Payload->GetData() + relayPacket.Payload->GetLength()),
+        std::vector<uint8_t>(expected.GetData(), expected.GetData() + expected.GetLength()));
+}
+
+TEST(NetworkRelayQueueTest, ticks)
+{
+    NetworkRelayQueue queue;
+
+    auto tick = CreatePacket(NETWORK_COMMAND_TICK, 100);
+    *tick << (uint32_t)0x1234 << (uint32_t)0;
+
+    NetworkTickBatch batch;
+    batch.Reset(101, 0x5678, 0, "");
+    uint8_t action[16] = {};
+    batch.AddAction(1, action, sizeof(action));
+    auto tickBatch = batch.CreatePacket();
+
+    auto gameAction = CreatePacket(NETWORK_COMMAND_GAME_ACTION, 101);
+    *gameAction << (uint32_t)7;
+
+    auto playerList = CreatePacket(NETWORK_COMMAND_PLAYERLIST, 102);
+    *playerList << (uint8_t)0;
+
+    ASSERT_TRUE(queue.Push(*tick));
+    ASSERT_TRUE(queue.Push(*tickBatch));
+    ASSERT_TRUE(queue.Push(*gameAction));
+    ASSERT_TRUE(queue.Push(*playerList));
+    ASSERT_EQ(queue.GetCount(), 4u);
+
+    // Nothing is passed on before the relay has run the tick itself.
+    NetworkRelayPacket relayPacket;
+    ASSERT_FALSE(queue.Pop(99, relayPacket));
+
+    ExpectPop(queue, 100, *tick, 100);
+    ASSERT_FALSE(queue.Pop(100, relayPacket));
+
+    ExpectPop(queue, 101, *tickBatch, 101);
+    ExpectPop(queue, 101, *gameAction, 101);
+    ASSERT_FALSE(queue.Pop(101, relayPacket));
+
+    ExpectPop(queue, 102, *playerList, 102);
+    ASSERT_EQ(queue.GetCount(), 0u);
+}
+
+TEST(NetworkRelayQueueTest, untimed)
+{
+    NetworkRelayQueue queue;
+
+    auto tick = CreatePacket(NETWORK_COMMAND_TICK, 200);
+    std::unique_ptr<NetworkPacket> chat(NetworkPacket::Allocate());
+    *chat << (uint32_t)NETWORK_COMMAND_CHAT;
+    chat->WriteString("hello");
+
+    ASSERT_TRUE(queue.Push(*tick));
+    ASSERT_TRUE(queue.Push(*chat));
+
+    // Untimed packets keep their place behind the tick they were received after.
+    NetworkRelayPacket relayPacket;
+    ASSERT_FALSE(queue.Pop(199, relayPacket));
+    ExpectPop(queue, 200, *tick, 200);
+    ASSERT_TRUE(queue.Pop(0, relayPacket));
+    ASSERT_FALSE(relayPacket.Timed);
+    ASSERT_EQ(relayPacket.Payload->GetCommand(), NETWORK_COMMAND_CHAT);
+}
+
+TEST(NetworkRelayQueueTest, dropped)
+{
+    NetworkRelayQueue queue;
+
+    // Packets between the relay and the server are not passed on.
+    std::unique_ptr<NetworkPacket> map(NetworkPacket::Allocate());
+    *map << (uint32_t)NETWORK_COMMAND_MAP << (uint32_t)0;
+    ASSERT_FALSE(queue.Push(*map));
+
+    // A tick packet too short to hold the tick.
+    std::unique_ptr<NetworkPacket> truncated(NetworkPacket::Allocate());
+    *truncated << (uint32_t)NETWORK_COMMAND_TICK;
+    ASSERT_FALSE(queue.Push(*truncated));
+
+    ASSERT_EQ(queue.GetCount(), 0u);
+    queue.Push(*CreatePacket(NETWORK_COMMAND_TICK, 1));
+    queue.Clear();
+    ASSERT_EQ(queue.GetCount(), 0u);
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include <gtest/gtest.h>
+#    include <memory>
+#    include <openrct2/network/NetworkResyncHistory.h>
+#    include <openrct2/network/NetworkTypes.h>
+#    include <vector>
+
+static NetworkPacketPayloadPtr CreatePayload(uint32_t command, uint32_t tick, size_t extraSize = 0)
+{
+    NetworkPacket packet;
+    packet << command << tick;
+    std::vector<uint8_t> extra(extraSize);
+    packet.Write(extra.data(), extra.size());
+    return std::make_shared<const NetworkPacketPayload>(packet);
+}
+
+// A tick batch followed by one game action for every tick.
+static std::vector<NetworkPacketPayloadPtr> PushTicks(NetworkResyncHistory& history, uint32_t from, uint32_t to)
+{
+    std::vector<NetworkPacketPayloadPtr> payloads;
+    for (uint32_t tick = from; tick <= to; tick++)
+    {
+        payloads.push_back(CreatePayload(NETWORK_COMMAND_TICK_BATCH, tick));
+        payloads.push_back(CreatePayload(NETWORK_COMMAND_GAME_ACTION, tick));
+        history.Push(tick, payloads[payloads.size() - 2]);
+        history.Push(tick, payloads.back());
+    }
+    return payloads;
+}
+
+TEST(NetworkResyncHistoryTest, trim_ticks)
+{
+    NetworkResyncHistory history(10, 1024 * 1024);
+    history.Reset(100);
+    uint64_t sequence = history.GetSequence();
+
+    PushTicks(history, 100, 110);
+    ASSERT_EQ(history.GetFirstTick(), 100u);
+    ASSERT_EQ(history.GetCount(), 22u);
+
+    // Tick 100 is more than 10 ticks behind now.
+    PushTicks(history, 111, 111);
+    ASSERT_EQ(history.GetFirstTick(), 101u);
+    ASSERT_EQ(history.GetCount(), 22u);
+    ASSERT_EQ(history.GetSequence(), sequence + 24);
+    ASSERT_FALSE(history.Contains(sequence));
+    ASSERT_TRUE(history.Contains(sequence + 2));
+    ASSERT_EQ(history.GetPacketsSince(sequence + 2).size(), 22u);
+    ASSERT_TRUE(history.GetPacketsSince(sequence).empty());
+}
+
+TEST(NetworkResyncHistoryTest, trim_size)
+{
+    NetworkResyncHistory history(1000, 1024);
+    history.Reset(0);
+
+    auto first = CreatePayload(NETWORK_COMMAND_GAME_ACTION, 0, 500);
+    history.Push(0, first);
+    history.Push(0, CreatePayload(NETWORK_COMMAND_GAME_ACTION, 0, 500));
+    ASSERT_EQ(history.GetCount(), 2u);
+    ASSERT_EQ(history.GetFirstTick(), 0u);
+
+    // The packets of tick 0 no longer fit, tick 1 is the first one that is still complete.
+    history.Push(1, CreatePayload(NETWORK_COMMAND_GAME_ACTION, 1, 500));
+    ASSERT_EQ(history.GetCount(), 2u);
+    ASSERT_LE(history.GetSize(), 1024u);
+    ASSERT_EQ(history.GetFirstTick(), 1u);
+
+    std::vector<NetworkPacketPayloadPtr> packets;
+    ASSERT_FALSE(history.GetPacketsFrom(0, 0, packets));
+    ASSERT_TRUE(history.GetPacketsFrom(1, 0, packets));
+    ASSERT_EQ(packets.size(), 1u);
+}
+
+TEST(NetworkResyncHistoryTest, packets_from_tick)
+{
+    NetworkResyncHistory history(100, 1024 * 1024);
+    history.Reset(10);
+    auto payloads = PushTicks(history, 10, 14);
+
+    std::vector<NetworkPacketPayloadPtr> packets;
+    ASSERT_TRUE(history.GetPacketsFrom(12, 0, packets));
+    ASSERT_EQ(packets, std::vector<NetworkPacketPayloadPtr>(payloads.begin() + 4, payloads.end()));
+
+    // A client that was paused at tick 12 has already run its game action.
+    std::vector<NetworkPacketPayloadPtr> paused;
+    auto pausedAction = CreatePayload(NETWORK_COMMAND_GAME_ACTION, 15);
+    history.Push(15, pausedAction);
+    ASSERT_TRUE(history.GetPacketsFrom(15, 1, paused));
+    ASSERT_TRUE(paused.empty());
+
+    // It can not have run more game actions than the server sent before the tick itself.
+    std::vector<NetworkPacketPayloadPtr> invalid;
+    ASSERT_FALSE(history.GetPacketsFrom(14, 1, invalid));
+    ASSERT_FALSE(history.GetPacketsFrom(15, 2, invalid));
+    ASSERT_FALSE(history.GetPacketsFrom(9, 0, invalid));
+}
+
+TEST(NetworkResyncHistoryTest, hashes)
+{
+    NetworkResyncHistory history(10, 1024 * 1024);
+    history.Reset(0);
+    history.SetHash(0, "0123");
+    PushTicks(history, 0, 5);
+    ASSERT_TRUE(history.IsConfirmed(0, "0123"));
+    ASSERT_FALSE(history.IsConfirmed(0, "4567"));
+    ASSERT_FALSE(history.IsConfirmed(1, "0123"));
+
+    // Hashes of ticks that are no longer complete are forgotten with them.
+    PushTicks(history, 6, 11);
+    ASSERT_FALSE(history.IsConfirmed(0, "0123"));
+
+    history.SetHash(11, "89ab");
+    uint64_t sequence = history.GetSequence();
+    history.Reset(12);
+    ASSERT_FALSE(history.IsConfirmed(11, "89ab"));
+    ASSERT_EQ(history.GetCount(), 0u);
+    ASSERT_FALSE(history.Contains(sequence));
+    ASSERT_TRUE(history.Contains(history.GetSequence()));
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include <gtest/gtest.h>
+#    include <memory>
+#    include <openrct2/network/NetworkTickBatch.h>
+#    include <openrct2/network/NetworkTypes.h>
+#    include <vector>
+
+static std::unique_ptr<NetworkPacket> RoundTrip(const NetworkTickBatch& batch, NetworkTickBatch& result)
+{
+    auto packet = batch.CreatePacket();
+
+    // Read the packet back the way it arrives on the other end.
+    auto received = std::make_unique<NetworkPacket>();
+    received->Data = packet->Data;
+    received->Size = (uint16_t)packet->Data->size();
+
+    uint32_t command;
+    *received >> command;
+    EXPECT_EQ(command, (uint32_t)NETWORK_COMMAND_TICK_BATCH);
+    EXPECT_TRUE(result.Read(*received));
+    return packet;
+}
+
+TEST(NetworkTickBatchTest, empty)
+{
+    NetworkTickBatch batch;
+    batch.Reset(1234, 0xDEADBEEF, NETWORK_TICK_FLAG_CHECKSUMS, "0123456789abcdef");
+
+    NetworkTickBatch result;
+    RoundTrip(batch, result);
+    ASSERT_EQ(result.Tick, 1234u);
+    ASSERT_EQ(result.Srand0, 0xDEADBEEF);
+    ASSERT_EQ(result.Flags, (uint32_t)NETWORK_TICK_FLAG_CHECKSUMS);
+    ASSERT_EQ(result.Checksum, "0123456789abcdef");
+    ASSERT_EQ(result.GetNumActions(), 0u);
+}
+
+TEST(NetworkTickBatchTest, actions)
+{
+    NetworkTickBatch batch;
+    batch.Reset(42, 7, 0, "");
+
+    // Enough repetitive data to be worth compressing, as serialised actions usually are.
+    std::vector<std::vector<uint8_t>> actions;
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        actions.emplace_back(24 + i, i);
+        ASSERT_TRUE(batch.AddAction(i, actions.back().data(), actions.back().size()));
+    }
+
+    NetworkTickBatch result;
+    auto packet = RoundTrip(batch, result);
+    ASSERT_EQ(result.Tick, 42u);
+    ASSERT_EQ(result.Srand0, 7u);
+    ASSERT_NE(result.Flags & NETWORK_TICK_FLAG_COMPRESSED, 0u);
+    ASSERT_TRUE(result.Checksum.empty());
+    ASSERT_EQ(result.GetNumActions(), actions.size());
+    for (size_t i = 0; i < actions.size(); i++)
+    {
+        auto action = result.GetAction(i);
+        ASSERT_EQ(action.Type, i);
+        ASSERT_EQ(std::vector<uint8_t>(action.Data, action.Data + action.Size), actions[i]);
+    }
+}
+
+TEST(NetworkTickBatchTest, full)
+{
+    NetworkTickBatch batch;
+    batch.Reset(0, 0, 0, "");
+
+    std::vector<uint8_t> action(1024);
+    size_t numAdded = 0;
+    while (batch.AddAction(0, action.data(), action.size()))
+    {
+        numAdded++;
+    }
+    ASSERT_EQ(batch.GetNumActions(), numAdded);
+    ASSERT_LT(numAdded * action.size(), NETWORK_TICK_BATCH_MAX_SIZE);
+
+    // Even without compression the batch has to fit into a single packet.
+    auto packet = batch.CreatePacket();
+    ASSERT_LT(packet->Data->size(), (size_t)UINT16_MAX);
+}
+
+TEST(NetworkTickBatchTest, malformed)
+{
+    NetworkTickBatch batch;
+    batch.Reset(0, 0, 0, "");
+    std::vector<uint8_t> action(16);
+    batch.AddAction(0, action.data(), action.size());
+
+    auto packet = batch.CreatePacket();
+    NetworkPacket received;
+    received.Data = packet->Data;
+    // Cut off the end of the last action.
+    received.Size = (uint16_t)(packet->Data->size() - 1);
+
+    uint32_t command;
+    received >> command;
+    NetworkTickBatch result;
+    ASSERT_FALSE(result.Read(received));
+}
+
+#endif
@@ -98,6 +98,100 @@ TEST_P(ReplayTests, RunReplay)
     }
 }
 
+TEST_P(ReplayTests, RecordReplay)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    core_init();
+
+    auto testData = GetParam();
+    auto replayFile = testData.filePath;
+    auto recordedFile = "test_record_" + testData.name;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    // Normalising plays the replay while recording it again in the current format.
+    bool startedNormalise = replayManager->NormaliseReplay(replayFile, recordedFile);
+    ASSERT_TRUE(startedNormalise);
+
+    while (replayManager->IsNormalising())
+    {
+        gs->UpdateLogic();
+    }
+
+    bool startedReplay = replayManager->StartPlayback(recordedFile);
+    ASSERT_TRUE(startedReplay);
+
+    while (replayManager->IsReplaying())
+    {
+        gs->UpdateLogic();
+        ASSERT_TRUE(replayManager->IsPlaybackStateMismatching() == false);
+    }
+}
+
+TEST_P(ReplayTests, SeekReplay)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    core_init();
+
+    auto testData = GetParam();
+    auto replayFile = testData.filePath;
+    auto recordedFile = "test_seek_" + testData.name;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    // Use the park of the test replay to record a new one with keyframes.
+    bool startedReplay = replayManager->StartPlayback(replayFile);
+    ASSERT_TRUE(startedReplay);
+    replayManager->StopPlayback();
+
+    bool startedRecording = replayManager->StartRecording(recordedFile, 350, 100);
+    ASSERT_TRUE(startedRecording);
+
+    while (replayManager->IsRecording())
+    {
+        gs->UpdateLogic();
+    }
+
+    startedReplay = replayManager->StartPlayback(recordedFile);
+    ASSERT_TRUE(startedReplay);
+    uint32_t tickStart = gCurrentTicks;
+
+    ReplayRecordInfo info;
+    ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+    ASSERT_EQ(info.NumKeyframes, 3u);
+
+    ASSERT_TRUE(replayManager->SeekPlayback(250));
+    ASSERT_EQ(gCurrentTicks, tickStart + 250);
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    ASSERT_TRUE(replayManager->SeekPlayback(50));
+    ASSERT_EQ(gCurrentTicks, tickStart + 50);
+
+    while (replayManager->IsReplaying())
+    {
+        gs->UpdateLogic();
+        ASSERT_TRUE(replayManager->IsPlaybackStateMismatching() == false);
+    }
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
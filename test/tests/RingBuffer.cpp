@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <deque>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/RingBuffer.h>
+#include <stdint.h>
+
+// Amount of elements to push into the buffer, enough to make it grow several times.
+constexpr size_t TEST_PUSH_COUNT = 1000;
+
+TEST(RingBufferTest, all)
+{
+    RingBuffer<size_t> buffer1;
+    ASSERT_EQ(buffer1.empty(), true);
+
+    // Mirror the effects of buffer1 into buffer2 to compare.
+    std::deque<size_t> buffer2;
+
+    // Push to both ends while consuming from the front, so the ring wraps around as it grows.
+    for (size_t i = 0; i < TEST_PUSH_COUNT; i++)
+    {
+        if (i % 5 == 0)
+        {
+            buffer1.push_front(i);
+            buffer2.push_front(i);
+        }
+        else
+        {
+            buffer1.push_back(i);
+            buffer2.push_back(i);
+        }
+
+        if (i % 3 == 0)
+        {
+            buffer1.pop_front();
+            buffer2.pop_front();
+        }
+
+        ASSERT_EQ(buffer1.size(), buffer2.size());
+    }
+
+    ASSERT_EQ(buffer1.empty(), false);
+    ASSERT_GE(buffer1.capacity(), buffer1.size());
+
+    // Compare contents.
+    {
+        ASSERT_EQ(buffer1.front(), buffer2.front());
+        ASSERT_EQ(buffer1.back(), buffer2.back());
+
+        for (size_t i = 0; i < buffer1.size(); i++)
+        {
+            ASSERT_EQ(buffer1[i], buffer2[i]);
+        }
+    }
+
+    // Clear
+    {
+        buffer1.clear();
+        ASSERT_EQ(buffer1.empty(), true);
+        ASSERT_EQ(buffer1.size(), size_t(0));
+    }
+
+    SUCCEED();
+}
+
+TEST(RingBufferTest, releases_popped_elements)
+{
+    RingBuffer<std::shared_ptr<int32_t>> buffer;
+    auto element = std::make_shared<int32_t>(1);
+    buffer.push_back(element);
+    ASSERT_EQ(element.use_count(), 2);
+
+    buffer.pop_front();
+    ASSERT_EQ(element.use_count(), 1);
+    ASSERT_EQ(buffer.empty(), true);
+}
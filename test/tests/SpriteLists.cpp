@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/actions/GuestSetNameAction.hpp>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/world/Sprite.h>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class SpriteListsTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+    static std::vector<uint16_t> GetLinkedPeeps()
+    {
+        std::vector<uint16_t> result;
+        uint16_t spriteIndex;
+        Peep* peep;
+        FOR_ALL_PEEPS (spriteIndex, peep)
+        {
+            result.push_back(spriteIndex);
+        }
+        return result;
+    }
+
+    static std::vector<uint16_t> GetDensePeeps()
+    {
+        std::vector<uint16_t> result;
+        const auto& dense = sprite_list_get_dense(SPRITE_LIST_PEEP);
+        for (auto it = dense.rbegin(); it != dense.rend(); it++)
+        {
+            if (*it != SPRITE_INDEX_NULL)
+            {
+                result.push_back(*it);
+            }
+        }
+        return result;
+    }
+
+    static void RenameGuest(Peep* guest, const std::string& name)
+    {
+        auto renameAction = GuestSetNameAction(guest->sprite_index, name);
+        auto result = GameActions::Execute(&renameAction);
+        ASSERT_EQ(result->Error, GA_ERROR::OK);
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> SpriteListsTest::_context;
+
+TEST_F(SpriteListsTest, dense_peeps_follow_renames)
+{
+    std::vector<Peep*> guests;
+    for (int32_t i = 0; i < 10; i++)
+    {
+        Peep* guest = Peep::Generate({ 32 * 10, 32 * 10, 112 });
+        ASSERT_NE(guest, nullptr);
+        guests.push_back(guest);
+    }
+    ASSERT_EQ(GetDensePeeps(), GetLinkedPeeps());
+
+    // Renaming a guest moves it to its place in the sorted peep list.
+    RenameGuest(guests[3], "Aaron");
+    ASSERT_EQ(GetDensePeeps(), GetLinkedPeeps());
+    RenameGuest(guests[7], "Zoe");
+    ASSERT_EQ(GetDensePeeps(), GetLinkedPeeps());
+
+    peep_sort();
+    ASSERT_EQ(GetDensePeeps(), GetLinkedPeeps());
+
+    for (auto guest : guests)
+    {
+        guest->Remove();
+    }
+    ASSERT_EQ(GetDensePeeps(), GetLinkedPeeps());
+}